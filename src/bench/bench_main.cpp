@@ -0,0 +1,1446 @@
+// ============================================================
+// File: src/bench/bench_main.cpp
+// Role: 학습 pass 처리량 벤치마크 (Vulkan + CPU 레퍼런스)
+// ============================================================
+//
+// 합성 장면(N개 랜덤 가우시안) × 해상도 조합을 sweep하며
+// forward / loss / backward / step(1 iteration 전체) 시간을 측정
+//
+//   Vulkan: pass별 GPU timestamp + step은 host wall-clock
+//           (파라미터 업로드 → 제출/대기 → loss/grad 다운로드 → SGD)
+//   CPU   : CpuReference.hpp 함수별 wall-clock
+//
+// 결과는 JSON (warmup/반복 횟수, mean/stddev/min/median/max)
+// → run 간 diff / 회귀 비교용
+//
+// 실행 예시 (build 폴더 기준):
+//   gaussian_bench --counts 100,10000 --res 64,256 --reps 20 --out bench.json
+//   gaussian_bench --device llvmpipe --cpu          (lavapipe + CPU 기준선)
+//   gaussian_bench --counters counters/             (계측 빌드 카운터 + heatmap)
+//
+// --counters: 측정과 별도로 INSTRUMENT 특수화 pipeline으로 1 step 더 실행
+//   → pass별 평가 수 / 낭비 비율 / early-term / atomic / 블록 불균형 + 히스토그램
+//   → DIR/N<n>_<w>x<h>_<pass>_*.ppm heatmap, JSON "counters" 배열
+//
+// --grad-modes: backward 누적 방식별로 같은 조합 반복 (TrainPasses.hpp GradMode)
+//   → Vulkan 행마다 "grad", backward 행은 "reproducible"
+//      (같은 파라미터로 step 2회 → grads 버퍼 비트 비교)
+//   → deterministic은 "reproducible_sampled"도 기록: 타일 K = 격자 - 1개 복원 추출
+//      (같은 타일 중복 거의 확실) sampled step 2회 비교. N > GRAD_MAX_CHUNK (기본 sweep의
+//      100000 이상)이면 구간 여러 개 → 구간 사이 transmittance 이어받기까지 검사
+//
+// --batch S: 같은 (N, 해상도) 장면 S개를 BATCHED pipeline 1 submit으로 학습
+//   → "batch_gpu" (GPU timestamp) / "batch_step" (host wall) 행, "scenes": S
+//   → 장면당 시간 = median / S 를 단일 장면 "step"과 비교 (TrainBatch.hpp)
+//
+// --schedule: sweep의 모든 Vulkan 조합을 독립 학습 job으로 JobScheduler에 투입
+//   → 순차 (job 1개씩 제출/대기) vs 동시 (전체 제출) wall time, JSON "scheduler"
+//   → 작은 조합일수록 높은 priority (큰 job 사이에서 latency 확인용)
+//   --queues Q / --sched-workers T / --sched-policy rr|priority
+//
+// --oit: 깊이 있는 장면 (z ~ [0, --oit-depth])에서 정렬 경로 vs weighted blended OIT
+//   → 정렬 경로 = CPU 깊이 정렬 + gaussian.comp / backward.comp
+//   → 행: "depth_sort" (host), "sorted_forward/backward", "oit_forward/backward" (GPU)
+//   → JSON "oit": 속도비 + 이미지 오차 (RMSE / max / PSNR) + gradient cosine
+//
+// --fused: 분리 pass (forward → loss → backward) vs 융합 타일 kernel (train_fused.comp)
+//   → 행: "separate_gpu" / "fused_gpu" (GPU), "separate_step" / "fused_step" (host, readback 포함)
+//   → JSON "fused": 속도비, loss 상대 오차, grads 최대 차이 (고정소수점 단위), halo 중복 렌더 비율
+//   → --ssim 0 이면 L1 전용 변형 (halo 없음)
+// ============================================================
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+
+#include "common/GaussianTypes.hpp"
+#include "common/CpuReference.hpp"
+#include "common/SceneGen.hpp"
+#include "engine/VkEngine.hpp"
+#include "engine/VkBuffer.hpp"
+#include "engine/VkCompute.hpp"
+#include "engine/VkTimer.hpp"
+#include "engine/JobScheduler.hpp"
+#include "common/DepthSort.hpp"
+#include "train/TrainPasses.hpp"
+#include "train/TrainBatch.hpp"
+#include "train/Counters.hpp"
+#include "utils/JsonIO.hpp"
+
+namespace {
+
+// ------------------------------------------------------------
+// 벤치 설정 (CLI)
+// ------------------------------------------------------------
+struct BenchConfig {
+    std::vector<uint32_t> counts      = { 100, 1000, 10000, 100000, 1000000 };
+    std::vector<uint32_t> resolutions = { 64, 256, 1024 };  // 정사각형 W = H
+    uint32_t    warmup      = 3;
+    uint32_t    reps        = 10;
+    float       ssimWeight  = 0.2f;
+    std::string device;                    // 비어있으면 discrete 우선
+    bool        pushDescriptors = true;    // false = 공유 descriptor pool fallback
+    std::string shaderDir   = "../src/shaders/";
+    std::string outPath     = "bench.json";
+    std::string countersDir;               // 비어있으면 계측 안 함
+    std::vector<gs::GradMode> gradModes = { gs::GRAD_ATOMIC };
+    uint32_t    batchScenes = 0;           // 0 = 배치 측정 안 함
+    bool        schedule    = false;       // JobScheduler 동시 학습 측정
+    uint32_t    schedWorkers  = 0;         // 0 = hardware_concurrency
+    uint32_t    computeQueues = 1;
+    gs::SchedulePolicy schedPolicy = gs::SchedulePolicy::Priority;
+    bool        oit         = false;       // 정렬 vs OIT 비교
+    bool        fused       = false;       // 분리 pass vs 융합 타일 kernel
+    float       oitDepth    = 1.0f;        // 장면 깊이 범위 = RenderPC.depthScale
+    bool        runGpu      = true;
+    bool        runCpu      = false;
+    double      maxWork     = 2e10;        // GPU: 픽셀 × 가우시안 상한
+    double      cpuMaxWork  = 5e8;         // CPU: 픽셀 × 가우시안 상한
+    gs::SceneGenConfig scene;
+};
+
+// ------------------------------------------------------------
+// 결과 1줄 = (backend, N, 해상도, stage)
+// ------------------------------------------------------------
+struct Stats {
+    double mean = 0, stddev = 0, min = 0, median = 0, max = 0;
+};
+
+struct ResultRow {
+    std::string backend;   // "vulkan" | "cpu"
+    uint32_t    gaussians = 0;
+    uint32_t    width = 0, height = 0;
+    std::string stage;     // "forward" | "loss" | "backward" | "step"
+    std::string grad;      // "atomic" | "deterministic" (vulkan만)
+    int         reproducible = -1;  // backward: 1 = 2회 실행 grads 비트 동일, -1 = 미측정
+    int         reproducibleSampled = -1;  // backward (deterministic): 중복 타일 sampled step 2회 비교
+    uint32_t    scenes = 1;         // batch_*: 한 submit에 학습한 장면 수
+    std::vector<double> samplesMs;
+    bool        skipped = false;
+    std::string reason;
+};
+
+// 스케줄러 측정 (동시 실행 기준 job별 통계)
+struct SchedJobRow {
+    uint32_t gaussians = 0;
+    uint32_t width = 0, height = 0;
+    int32_t  priority = 0;
+    uint32_t steps = 0;
+    double   totalMs = 0;            // 제출 → 마지막 step 완료
+    std::vector<double> waitMs, gpuMs, stepMs;
+    std::vector<uint32_t> queueSubmits;
+};
+
+struct SchedReport {
+    bool     ran = false;
+    uint32_t workers = 0;
+    uint32_t queues = 0;
+    const char* policy = "priority";
+    double   sequentialMs = 0;       // job 1개씩 제출 → 대기
+    double   concurrentMs = 0;       // 전체 제출 → waitAll
+    std::vector<SchedJobRow> jobs;
+};
+
+// OIT 비교 (N, 해상도)마다 1줄, 시간은 같은 조합의 depth_sort/sorted_*/oit_* 행 median
+struct OitRow {
+    uint32_t gaussians = 0;
+    uint32_t width = 0, height = 0;
+    double   sortMs = 0, sortedFwdMs = 0, sortedBwdMs = 0, oitFwdMs = 0, oitBwdMs = 0;
+    double   rmse = 0, maxAbs = 0, psnr = 0;   // OIT 이미지 vs 정렬 이미지 (RGB, [0, 1])
+    double   lossSorted = 0, lossOit = 0;      // 같은 target에 대한 전체 loss
+    double   cosColor = 0, cosPos = 0;         // gradient 방향 일치도 (정렬 경로 기준)
+};
+
+// 융합 step 비교 (N, 해상도)마다 1줄
+struct FusedRow {
+    uint32_t gaussians = 0;
+    uint32_t width = 0, height = 0;
+    const char* variant = "ssim";      // "ssim" | "l1"
+    double   separateGpuMs = 0, fusedGpuMs = 0, separateStepMs = 0, fusedStepMs = 0;
+    double   lossRelDiff = 0;          // |fused - separate| / separate
+    int64_t  gradMaxDiff = 0;          // grads int 최대 차이 (1 = 1 / GRAD_SCALE)
+    double   renderOverdraw = 1.0;     // 융합 kernel 렌더 픽셀 수 / 이미지 픽셀 수
+};
+
+// 계측 결과 1줄 = (N, 해상도, pass)
+struct CounterRow {
+    uint32_t    gaussians = 0;
+    uint32_t    width = 0, height = 0;
+    std::string pass;      // "forward" | "backward"
+    gs::CounterSummary summary;
+};
+
+Stats computeStats(std::vector<double> v) {
+    Stats s;
+    if (v.empty()) return s;
+    std::sort(v.begin(), v.end());
+    double sum = 0;
+    for (double x : v) sum += x;
+    s.mean = sum / v.size();
+    double var = 0;
+    for (double x : v) var += (x - s.mean) * (x - s.mean);
+    s.stddev = v.size() > 1 ? std::sqrt(var / (v.size() - 1)) : 0.0;  // 표본 표준편차
+    s.min = v.front();
+    s.max = v.back();
+    s.median = (v.size() % 2) ? v[v.size() / 2] : 0.5 * (v[v.size() / 2 - 1] + v[v.size() / 2]);
+    return s;
+}
+
+double nowMs() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+std::vector<uint32_t> parseList(const char* s) {
+    std::vector<uint32_t> out;
+    std::string str(s);
+    size_t pos = 0;
+    while (pos < str.size()) {
+        size_t comma = str.find(',', pos);
+        if (comma == std::string::npos) comma = str.size();
+        out.push_back(uint32_t(std::strtod(str.substr(pos, comma - pos).c_str(), nullptr)));  // "1e6" 허용
+        pos = comma + 1;
+    }
+    return out;
+}
+
+gs::Distribution parseDist(const char* s) {
+    if (std::strcmp(s, "uniform") == 0)    return gs::Distribution::Uniform;
+    if (std::strcmp(s, "loguniform") == 0) return gs::Distribution::LogUniform;
+    if (std::strcmp(s, "constant") == 0)   return gs::Distribution::Constant;
+    throw std::runtime_error(std::string("Unknown distribution: ") + s);
+}
+
+const char* distName(gs::Distribution d) {
+    switch (d) {
+    case gs::Distribution::Uniform:    return "uniform";
+    case gs::Distribution::LogUniform: return "loguniform";
+    case gs::Distribution::Constant:   return "constant";
+    }
+    return "?";
+}
+
+const char* gradModeName(gs::GradMode m) {
+    return (m == gs::GRAD_DETERMINISTIC) ? "deterministic" : "atomic";
+}
+
+std::vector<gs::GradMode> parseGradModes(const char* s) {
+    std::vector<gs::GradMode> out;
+    std::string str(s);
+    size_t pos = 0;
+    while (pos < str.size()) {
+        size_t comma = str.find(',', pos);
+        if (comma == std::string::npos) comma = str.size();
+        std::string name = str.substr(pos, comma - pos);
+        if      (name == "atomic")        out.push_back(gs::GRAD_ATOMIC);
+        else if (name == "deterministic") out.push_back(gs::GRAD_DETERMINISTIC);
+        else throw std::runtime_error("Unknown grad mode: " + name);
+        pos = comma + 1;
+    }
+    if (out.empty()) throw std::runtime_error("Empty --grad-modes");
+    return out;
+}
+
+void printUsage() {
+    printf(
+        "Usage: gaussian_bench [options]\n"
+        "  --counts a,b,..       Gaussian counts      (default 100,1000,10000,100000,1000000)\n"
+        "  --res a,b,..          square resolutions   (default 64,256,1024)\n"
+        "  --warmup N            warmup iterations    (default 3)\n"
+        "  --reps N              measured repetitions (default 10)\n"
+        "  --ssim λ              D-SSIM weight        (default 0.2)\n"
+        "  --device NAME         Vulkan device name substring (e.g. llvmpipe)\n"
+        "  --pool-descriptors    use the shared descriptor pool even if push descriptors exist\n"
+        "  --grad-modes a,b      backward accumulation: atomic,deterministic (default atomic)\n"
+        "  --batch S             also train S scenes per config in one batched submit\n"
+        "  --oit                 compare weighted-blended OIT against depth sort + sorted blend\n"
+        "  --oit-depth D         scene depth range for --oit (default 1.0)\n"
+        "  --fused               compare the fused per-tile train kernel against separate passes\n"
+        "  --schedule            run all Vulkan configs as concurrent jobs (sequential vs concurrent)\n"
+        "  --queues Q            compute queues to request (default 1)\n"
+        "  --sched-workers T     scheduler worker threads (default: hardware threads)\n"
+        "  --sched-policy P      rr|priority (default priority)\n"
+        "  --cpu / --no-gpu      enable CPU reference / disable Vulkan\n"
+        "  --max-work W          skip Vulkan configs with pixels*N > W (default 2e10)\n"
+        "  --cpu-max-work W      skip CPU configs with pixels*N > W    (default 5e8)\n"
+        "  --scale-dist D        uniform|loguniform|constant (default loguniform)\n"
+        "  --scale-min/--scale-max F      (default 1, 16 px)\n"
+        "  --opacity-dist D      uniform|loguniform|constant (default uniform)\n"
+        "  --opacity-min/--opacity-max F  (default 0.2, 1)\n"
+        "  --seed N              scene seed (default 42)\n"
+        "  --shaders DIR         SPIR-V directory (default ../src/shaders/)\n"
+        "  --out FILE            JSON output (default bench.json)\n"
+        "  --counters DIR        extra instrumented step per config: counters + heatmaps in DIR (must exist)\n");
+}
+
+BenchConfig parseArgs(int argc, char** argv) {
+    BenchConfig cfg;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        auto next = [&]() -> const char* {
+            if (i + 1 >= argc) throw std::runtime_error("Missing value for " + a);
+            return argv[++i];
+        };
+        if      (a == "--counts")       cfg.counts = parseList(next());
+        else if (a == "--res")          cfg.resolutions = parseList(next());
+        else if (a == "--warmup")       cfg.warmup = uint32_t(std::atoi(next()));
+        else if (a == "--reps")         cfg.reps = std::max(1, std::atoi(next()));
+        else if (a == "--ssim")         cfg.ssimWeight = float(std::atof(next()));
+        else if (a == "--device")       cfg.device = next();
+        else if (a == "--pool-descriptors") cfg.pushDescriptors = false;
+        else if (a == "--grad-modes")   cfg.gradModes = parseGradModes(next());
+        else if (a == "--batch")        cfg.batchScenes = uint32_t(std::max(0, std::atoi(next())));
+        else if (a == "--schedule")     cfg.schedule = true;
+        else if (a == "--oit")          cfg.oit = true;
+        else if (a == "--fused")        cfg.fused = true;
+        else if (a == "--oit-depth")    cfg.oitDepth = std::max(1e-3f, float(std::atof(next())));
+        else if (a == "--queues")       cfg.computeQueues = uint32_t(std::max(1, std::atoi(next())));
+        else if (a == "--sched-workers") cfg.schedWorkers = uint32_t(std::max(0, std::atoi(next())));
+        else if (a == "--sched-policy") {
+            std::string v = next();
+            if      (v == "rr")       cfg.schedPolicy = gs::SchedulePolicy::RoundRobin;
+            else if (v == "priority") cfg.schedPolicy = gs::SchedulePolicy::Priority;
+            else throw std::runtime_error("Unknown scheduler policy: " + v);
+        }
+        else if (a == "--cpu")          cfg.runCpu = true;
+        else if (a == "--no-gpu")       cfg.runGpu = false;
+        else if (a == "--max-work")     cfg.maxWork = std::atof(next());
+        else if (a == "--cpu-max-work") cfg.cpuMaxWork = std::atof(next());
+        else if (a == "--scale-dist")   cfg.scene.scaleDist = parseDist(next());
+        else if (a == "--scale-min")    cfg.scene.scaleMin = float(std::atof(next()));
+        else if (a == "--scale-max")    cfg.scene.scaleMax = float(std::atof(next()));
+        else if (a == "--opacity-dist") cfg.scene.opacityDist = parseDist(next());
+        else if (a == "--opacity-min")  cfg.scene.opacityMin = float(std::atof(next()));
+        else if (a == "--opacity-max")  cfg.scene.opacityMax = float(std::atof(next()));
+        else if (a == "--seed")         cfg.scene.seed = uint32_t(std::atoi(next()));
+        else if (a == "--shaders")      cfg.shaderDir = next();
+        else if (a == "--out")          cfg.outPath = next();
+        else if (a == "--counters")     cfg.countersDir = next();
+        else if (a == "--help" || a == "-h") { printUsage(); std::exit(0); }
+        else throw std::runtime_error("Unknown option: " + a);
+    }
+    return cfg;
+}
+
+// ------------------------------------------------------------
+// 학습 1 step의 host 측 처리 (main.cpp와 동일한 작업량)
+// ------------------------------------------------------------
+void applySGD(
+    std::vector<gs::GaussianParam>& gaussians,
+    const std::vector<glm::vec3>& dColor,
+    const std::vector<glm::vec2>& dPos,
+    uint32_t pixelCount
+) {
+    const float colorLR = 0.3f;
+    const float posLR = 30.0f;
+    for (size_t i = 0; i < gaussians.size(); i++) {
+        gaussians[i].color -= colorLR * dColor[i] / float(pixelCount);
+        gaussians[i].color = glm::clamp(gaussians[i].color, glm::vec3(0.0f), glm::vec3(1.0f));
+        gaussians[i].position.x -= posLR * dPos[i].x / float(pixelCount);
+        gaussians[i].position.y -= posLR * dPos[i].y / float(pixelCount);
+    }
+}
+
+// ------------------------------------------------------------
+// prepareTrainScene: 학습 대상 장면 + target 이미지 (다른 seed 장면을 GPU로 렌더)
+// ------------------------------------------------------------
+// pipes에 bufs/target 바인딩까지 끝낸 상태로 반환 (runVulkanConfig / 스케줄러 job 공용)
+// ------------------------------------------------------------
+gs::BufferBundle prepareTrainScene(
+    const BenchConfig& cfg,
+    gs::VkEngine& engine,
+    gs::TrainPipelines& pipes,
+    gs::TrainBuffers& bufs,
+    uint32_t N, uint32_t W, uint32_t H,
+    std::vector<gs::GaussianParam>& gaussians
+) {
+    const uint32_t pixelCount = W * H;
+    const VkDeviceSize imageSize  = VkDeviceSize(pixelCount) * sizeof(glm::vec4);
+    const VkDeviceSize paramsSize = VkDeviceSize(N) * sizeof(gs::GaussianParam);
+
+    gs::SceneGenConfig sceneCfg = cfg.scene;
+    sceneCfg.count = N; sceneCfg.width = W; sceneCfg.height = H;
+    gaussians = gs::generateScene(sceneCfg);
+    sceneCfg.seed += 1;
+    std::vector<gs::GaussianParam> targetScene = gs::generateScene(sceneCfg);
+
+    gs::BufferBundle targetBuf = gs::createBuffer(engine.device(), engine.physicalDevice(),
+        imageSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    gs::bindTrainBuffers(pipes, bufs);
+    gs::bindTarget(pipes, targetBuf);
+
+    VkCommandBuffer cmd = engine.commandBuffer();
+    gs::RenderPC renderPC{ W, H, N, 1.0f, gs::SAMPLE_NONE };
+    std::vector<glm::vec4> targetPixels(pixelCount);
+    gs::uploadToBuffer(engine.device(), bufs.params, targetScene.data(), paramsSize);
+    gs::beginOneTimeCommands(cmd);
+    gs::recordForward(cmd, pipes, renderPC);
+    vkEndCommandBuffer(cmd);
+    engine.submitAndWait(cmd);
+    vkResetCommandBuffer(cmd, 0);
+    gs::downloadFromBuffer(engine.device(), bufs.rendered, targetPixels.data(), imageSize);
+    gs::uploadToBuffer(engine.device(), targetBuf, targetPixels.data(), imageSize);
+    return targetBuf;
+}
+
+// ------------------------------------------------------------
+// Vulkan: (N, W×H) 1개 조합 측정
+// ------------------------------------------------------------
+void runVulkanConfig(
+    const BenchConfig& cfg,
+    gs::VkEngine& engine,
+    gs::TrainPipelines& pipes,
+    gs::TrainPipelines* counterPipes,
+    gs::TimestampPool& timer,
+    gs::GradMode gradMode,
+    uint32_t N, uint32_t W, uint32_t H,
+    std::vector<ResultRow>& rows,
+    std::vector<CounterRow>& counterRows
+) {
+    const uint32_t pixelCount = W * H;
+    const VkDeviceSize paramsSize = VkDeviceSize(N) * sizeof(gs::GaussianParam);
+    const VkDeviceSize gradsSize  = VkDeviceSize(N) * sizeof(gs::GaussianGrad);
+
+    std::vector<gs::GaussianParam> gaussians;
+    gs::TrainBuffers bufs = gs::createTrainBuffers(engine.device(), engine.physicalDevice(), N, W, H, gradMode);
+    gs::BufferBundle targetBuf = prepareTrainScene(cfg, engine, pipes, bufs, N, W, H, gaussians);
+
+    VkCommandBuffer cmd = engine.commandBuffer();
+    gs::RenderPC renderPC{ W, H, N, 1.0f, gs::SAMPLE_NONE };
+    gs::LossPC lossPC{ W, H, cfg.ssimWeight, gs::SAMPLE_NONE };
+
+    std::vector<double> fwd, loss, bwd, step;
+    std::vector<gs::GaussianGradInt> zeroGrads(N, gs::GaussianGradInt{});
+    std::vector<gs::GaussianGrad> grads;
+    std::vector<float> pixelLoss(pixelCount);
+    std::vector<glm::vec3> dColor(N);
+    std::vector<glm::vec2> dPos(N);
+    std::vector<double> ts;
+
+    for (uint32_t rep = 0; rep < cfg.warmup + cfg.reps; rep++) {
+        double t0 = nowMs();
+
+        gs::uploadToBuffer(engine.device(), bufs.params, gaussians.data(), paramsSize);
+        if (gradMode == gs::GRAD_ATOMIC) {
+            gs::uploadToBuffer(engine.device(), bufs.grads, zeroGrads.data(), gradsSize);
+        }
+
+        gs::beginOneTimeCommands(cmd);
+        gs::recordTimestampReset(cmd, timer);
+        gs::recordTimestamp(cmd, timer, 0);
+        gs::recordForward(cmd, pipes, renderPC);
+        gs::recordTimestamp(cmd, timer, 1);
+        gs::recordComputeBarrier(cmd);
+        gs::recordLoss(cmd, pipes, lossPC);
+        gs::recordTimestamp(cmd, timer, 2);
+        gs::recordComputeBarrier(cmd);
+        gs::recordBackwardPass(cmd, pipes, bufs, renderPC);
+        gs::recordTimestamp(cmd, timer, 3);
+        vkEndCommandBuffer(cmd);
+        engine.submitAndWait(cmd);
+        vkResetCommandBuffer(cmd, 0);
+
+        gs::downloadFromBuffer(engine.device(), bufs.loss, pixelLoss.data(), pixelCount * sizeof(float));
+        float totalLoss = 0.0f;
+        for (float l : pixelLoss) totalLoss += l;
+        gs::readGradients(engine.device(), bufs, N, grads);
+        for (uint32_t i = 0; i < N; i++) {
+            dColor[i] = grads[i].dColor;
+            dPos[i]   = glm::vec2(grads[i].dPosition);
+        }
+        applySGD(gaussians, dColor, dPos, pixelCount);
+
+        double t1 = nowMs();
+        if (rep < cfg.warmup) continue;
+
+        step.push_back(t1 - t0);
+        if (gs::readTimestampsMs(engine.device(), timer, ts)) {
+            fwd.push_back(ts[1] - ts[0]);
+            loss.push_back(ts[2] - ts[1]);
+            bwd.push_back(ts[3] - ts[2]);
+        }
+        (void)totalLoss;
+    }
+
+    // ---------- 재현성: 같은 파라미터로 2회 → grads 원본 비트 비교 ----------
+    std::vector<uint8_t> gradBits[2];
+    for (int run = 0; run < 2; run++) {
+        gs::uploadToBuffer(engine.device(), bufs.params, gaussians.data(), paramsSize);
+        if (gradMode == gs::GRAD_ATOMIC) {
+            gs::uploadToBuffer(engine.device(), bufs.grads, zeroGrads.data(), gradsSize);
+        }
+        gs::beginOneTimeCommands(cmd);
+        gs::recordTrainStep(cmd, pipes, bufs, renderPC, lossPC);
+        vkEndCommandBuffer(cmd);
+        engine.submitAndWait(cmd);
+        vkResetCommandBuffer(cmd, 0);
+        gradBits[run].resize(gradsSize);
+        gs::downloadFromBuffer(engine.device(), bufs.grads, gradBits[run].data(), gradsSize);
+    }
+    const bool reproducible = gradBits[0] == gradBits[1];
+
+    // deterministic: 중복 타일이 섞인 sampled step도 같은 비트여야 함
+    int reproducibleSampled = -1;
+    if (gradMode == gs::GRAD_DETERMINISTIC) {
+        const uint32_t grid = (W / gs::SAMPLE_TILE) * (H / gs::SAMPLE_TILE);
+        gs::SamplePC samplePC{ W, H, cfg.scene.seed, 0, gs::SAMPLE_TILES, grid > 0 ? grid - 1 : 0, 0, 0 };
+        if (gs::sampledTileCount(samplePC) > 0) {
+            gs::RenderPC sampledRender{ W, H, N, 1.0f, gs::SAMPLE_TILES };
+            gs::LossPC sampledLoss{ W, H, cfg.ssimWeight, gs::SAMPLE_TILES };
+            for (int run = 0; run < 2; run++) {
+                gs::uploadToBuffer(engine.device(), bufs.params, gaussians.data(), paramsSize);
+                gs::beginOneTimeCommands(cmd);
+                gs::recordTrainStepSampled(cmd, pipes, bufs, samplePC, sampledRender, sampledLoss);
+                vkEndCommandBuffer(cmd);
+                engine.submitAndWait(cmd);
+                vkResetCommandBuffer(cmd, 0);
+                gs::downloadFromBuffer(engine.device(), bufs.grads, gradBits[run].data(), gradsSize);
+            }
+            reproducibleSampled = (gradBits[0] == gradBits[1]) ? 1 : 0;
+        }
+    }
+
+    auto push = [&](const char* stage, std::vector<double>& samples) {
+        ResultRow r;
+        r.backend = "vulkan"; r.gaussians = N; r.width = W; r.height = H;
+        r.stage = stage; r.grad = gradModeName(gradMode); r.samplesMs = samples;
+        if (r.stage == "backward") {
+            r.reproducible = reproducible ? 1 : 0;
+            r.reproducibleSampled = reproducibleSampled;
+        }
+        if (samples.empty()) { r.skipped = true; r.reason = "timestamps unsupported"; }
+        rows.push_back(r);
+    };
+    push("forward", fwd);
+    push("loss", loss);
+    push("backward", bwd);
+    push("step", step);
+
+    // ---------- 계측 step (시간 측정에 포함하지 않음) ----------
+    // 계측 카운터는 backward.comp 전용 → deterministic이면 forward만 기록
+    if (counterPipes != nullptr) {
+        gs::bindTrainBuffers(*counterPipes, bufs);
+        gs::bindTarget(*counterPipes, targetBuf);
+        gs::uploadToBuffer(engine.device(), bufs.params, gaussians.data(), paramsSize);
+        if (gradMode == gs::GRAD_ATOMIC) {
+            gs::uploadToBuffer(engine.device(), bufs.grads, zeroGrads.data(), gradsSize);
+        }
+
+        gs::beginOneTimeCommands(cmd);
+        gs::recordCounterReset(cmd, bufs);
+        gs::recordTrainStep(cmd, *counterPipes, bufs, renderPC, lossPC);
+        vkEndCommandBuffer(cmd);
+        engine.submitAndWait(cmd);
+        vkResetCommandBuffer(cmd, 0);
+
+        const std::string prefix = cfg.countersDir + "/N" + std::to_string(N) + "_" +
+            std::to_string(W) + "x" + std::to_string(H);
+        const std::pair<const char*, gs::BufferBundle*> passes[] = {
+            { "forward",  &bufs.forwardCounters },
+            { "backward", &bufs.backwardCounters },
+        };
+        for (const auto& [pass, buffer] : passes) {
+            if (buffer == &bufs.backwardCounters && gradMode != gs::GRAD_ATOMIC) continue;
+            gs::CounterGrid grid = gs::readCounterGrid(engine.device(), *buffer, W, H);
+            CounterRow row;
+            row.gaussians = N; row.width = W; row.height = H;
+            row.pass = pass;
+            row.summary = gs::summarizeCounters(grid);
+            gs::printCounterSummary(pass, row.summary);
+            gs::saveCounterHeatmaps(prefix + "_" + pass, grid);
+            counterRows.push_back(row);
+        }
+    }
+
+    gs::destroyBuffer(engine.device(), targetBuf);
+    gs::destroyTrainBuffers(engine.device(), bufs);
+}
+
+// ------------------------------------------------------------
+// Vulkan 배치: 장면 S개 × (N, W×H) 를 1 submit으로 측정
+// ------------------------------------------------------------
+// 장면 s = seed + 2s 학습 대상, seed + 2s + 1 target (target도 배치 forward로 렌더)
+// host 작업량은 단일 장면 × S (업로드/다운로드/SGD 모두 packed 버퍼 1번)
+// ------------------------------------------------------------
+void runVulkanBatchConfig(
+    const BenchConfig& cfg,
+    gs::VkEngine& engine,
+    gs::TrainPipelines& batchPipes,
+    gs::TimestampPool& timer,
+    uint32_t S, uint32_t N, uint32_t W, uint32_t H,
+    std::vector<ResultRow>& rows
+) {
+    const gs::BatchLayout layout = gs::makeBatchLayout(std::vector<gs::BatchSceneSize>(S, { N, W, H }));
+    const uint32_t pixelCount = W * H;
+    const VkDeviceSize imageSize  = VkDeviceSize(layout.totalPixels) * sizeof(glm::vec4);
+    const VkDeviceSize paramsSize = VkDeviceSize(layout.totalGaussians) * sizeof(gs::GaussianParam);
+    const VkDeviceSize gradsSize  = VkDeviceSize(layout.totalGaussians) * sizeof(gs::GaussianGradInt);
+
+    std::vector<gs::GaussianParam> gaussians, targetScene;
+    gaussians.reserve(layout.totalGaussians);
+    targetScene.reserve(layout.totalGaussians);
+    gs::SceneGenConfig sceneCfg = cfg.scene;
+    sceneCfg.count = N; sceneCfg.width = W; sceneCfg.height = H;
+    for (uint32_t sc = 0; sc < S; sc++) {
+        sceneCfg.seed = cfg.scene.seed + 2 * sc;
+        std::vector<gs::GaussianParam> g = gs::generateScene(sceneCfg);
+        gaussians.insert(gaussians.end(), g.begin(), g.end());
+        sceneCfg.seed += 1;
+        g = gs::generateScene(sceneCfg);
+        targetScene.insert(targetScene.end(), g.begin(), g.end());
+    }
+
+    gs::TrainBuffers bufs = gs::createBatchTrainBuffers(engine.device(), engine.physicalDevice(), layout);
+    gs::BufferBundle targetBuf = gs::createBuffer(engine.device(), engine.physicalDevice(),
+        imageSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    gs::bindTrainBuffers(batchPipes, bufs);
+    gs::bindTarget(batchPipes, targetBuf);
+
+    VkCommandBuffer cmd = engine.commandBuffer();
+    {
+        std::vector<glm::vec4> targetPixels(layout.totalPixels);
+        gs::uploadToBuffer(engine.device(), bufs.params, targetScene.data(), paramsSize);
+        gs::beginOneTimeCommands(cmd);
+        gs::recordForwardBatched(cmd, batchPipes, layout);
+        vkEndCommandBuffer(cmd);
+        engine.submitAndWait(cmd);
+        vkResetCommandBuffer(cmd, 0);
+        gs::downloadFromBuffer(engine.device(), bufs.rendered, targetPixels.data(), imageSize);
+        gs::uploadToBuffer(engine.device(), targetBuf, targetPixels.data(), imageSize);
+    }
+
+    std::vector<double> gpu, step;
+    std::vector<gs::GaussianGradInt> zeroGrads(layout.totalGaussians, gs::GaussianGradInt{});
+    std::vector<gs::GaussianGrad> grads;
+    std::vector<float> sceneLoss;
+    std::vector<glm::vec3> dColor(N);
+    std::vector<glm::vec2> dPos(N);
+    std::vector<double> ts;
+
+    for (uint32_t rep = 0; rep < cfg.warmup + cfg.reps; rep++) {
+        double t0 = nowMs();
+
+        gs::uploadToBuffer(engine.device(), bufs.params, gaussians.data(), paramsSize);
+        gs::uploadToBuffer(engine.device(), bufs.grads, zeroGrads.data(), gradsSize);
+
+        gs::beginOneTimeCommands(cmd);
+        gs::recordTimestampReset(cmd, timer);
+        gs::recordTimestamp(cmd, timer, 0);
+        gs::recordTrainStepBatched(cmd, batchPipes, layout, cfg.ssimWeight);
+        gs::recordTimestamp(cmd, timer, 1);
+        vkEndCommandBuffer(cmd);
+        engine.submitAndWait(cmd);
+        vkResetCommandBuffer(cmd, 0);
+
+        gs::readBatchLosses(engine.device(), bufs, layout, sceneLoss);
+        gs::readGradients(engine.device(), bufs, layout.totalGaussians, grads);
+        for (uint32_t sc = 0; sc < S; sc++) {
+            const gs::BatchScene& info = layout.scenes[sc];
+            std::vector<gs::GaussianParam> sceneParams(gaussians.begin() + info.paramOffset,
+                gaussians.begin() + info.paramOffset + info.gaussCount);
+            for (uint32_t i = 0; i < N; i++) {
+                dColor[i] = grads[info.paramOffset + i].dColor;
+                dPos[i]   = glm::vec2(grads[info.paramOffset + i].dPosition);
+            }
+            applySGD(sceneParams, dColor, dPos, pixelCount);
+            std::copy(sceneParams.begin(), sceneParams.end(), gaussians.begin() + info.paramOffset);
+        }
+
+        double t1 = nowMs();
+        if (rep < cfg.warmup) continue;
+
+        step.push_back(t1 - t0);
+        if (gs::readTimestampsMs(engine.device(), timer, ts)) gpu.push_back(ts[1] - ts[0]);
+    }
+
+    auto push = [&](const char* stage, std::vector<double>& samples) {
+        ResultRow r;
+        r.backend = "vulkan"; r.gaussians = N; r.width = W; r.height = H;
+        r.stage = stage; r.grad = gradModeName(gs::GRAD_ATOMIC); r.scenes = S; r.samplesMs = samples;
+        if (samples.empty()) { r.skipped = true; r.reason = "timestamps unsupported"; }
+        rows.push_back(r);
+    };
+    push("batch_gpu", gpu);
+    push("batch_step", step);
+
+    gs::destroyBuffer(engine.device(), targetBuf);
+    gs::destroyTrainBuffers(engine.device(), bufs);
+}
+
+// ------------------------------------------------------------
+// OIT 비교: (N, W×H) 1개 조합
+// ------------------------------------------------------------
+// 매 rep: 정렬 경로 (CPU 정렬 → forward/loss/backward) 1회 + OIT 경로 1회
+//   OIT는 정렬 안 된 원래 배열 그대로 업로드
+// 오차/gradient는 정렬된 배열 하나로 두 경로 실행 (인덱스 일치, OIT는 순서 무관)
+// target = 다른 seed 장면을 정렬 경로로 렌더한 정확한 이미지
+// ------------------------------------------------------------
+double cosine(const std::vector<double>& a, const std::vector<double>& b) {
+    double dot = 0, na = 0, nb = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        dot += a[i] * b[i];
+        na  += a[i] * a[i];
+        nb  += b[i] * b[i];
+    }
+    return (na > 0 && nb > 0) ? dot / std::sqrt(na * nb) : 0.0;
+}
+
+void runVulkanOitConfig(
+    const BenchConfig& cfg,
+    gs::VkEngine& engine,
+    gs::TrainPipelines& pipes,
+    gs::TimestampPool& timer,
+    uint32_t N, uint32_t W, uint32_t H,
+    std::vector<ResultRow>& rows,
+    std::vector<OitRow>& oitRows
+) {
+    const uint32_t pixelCount = W * H;
+    const VkDeviceSize imageSize  = VkDeviceSize(pixelCount) * sizeof(glm::vec4);
+    const VkDeviceSize paramsSize = VkDeviceSize(N) * sizeof(gs::GaussianParam);
+    const VkDeviceSize gradsSize  = VkDeviceSize(N) * sizeof(gs::GaussianGradInt);
+    VkDevice device = engine.device();
+
+    gs::SceneGenConfig sceneCfg = cfg.scene;
+    sceneCfg.count = N; sceneCfg.width = W; sceneCfg.height = H;
+    sceneCfg.depthMax = cfg.oitDepth;
+    std::vector<gs::GaussianParam> gaussians = gs::generateScene(sceneCfg);
+    sceneCfg.seed += 1;
+    std::vector<gs::GaussianParam> targetScene = gs::sortByDepth(gs::generateScene(sceneCfg));
+
+    gs::TrainBuffers bufs = gs::createTrainBuffers(device, engine.physicalDevice(), N, W, H);
+    gs::BufferBundle targetBuf = gs::createBuffer(device, engine.physicalDevice(),
+        imageSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    gs::bindTrainBuffers(pipes, bufs);
+    gs::bindTarget(pipes, targetBuf);
+
+    VkCommandBuffer cmd = engine.commandBuffer();
+    gs::RenderPC renderPC{ W, H, N, 1.0f, gs::SAMPLE_NONE, cfg.oitDepth };
+    gs::LossPC lossPC{ W, H, cfg.ssimWeight, gs::SAMPLE_NONE };
+    std::vector<gs::GaussianGradInt> zeroGrads(N, gs::GaussianGradInt{});
+
+    auto submit = [&](auto&& record) {
+        gs::beginOneTimeCommands(cmd);
+        record();
+        vkEndCommandBuffer(cmd);
+        engine.submitAndWait(cmd);
+        vkResetCommandBuffer(cmd, 0);
+    };
+
+    // target (정확한 정렬 합성)
+    std::vector<glm::vec4> imageSorted(pixelCount), imageOit(pixelCount);
+    gs::uploadToBuffer(device, bufs.params, targetScene.data(), paramsSize);
+    submit([&] { gs::recordForward(cmd, pipes, renderPC); });
+    gs::downloadFromBuffer(device, bufs.rendered, imageSorted.data(), imageSize);
+    gs::uploadToBuffer(device, targetBuf, imageSorted.data(), imageSize);
+
+    // ---------- 시간: 정렬 경로 vs OIT 경로 ----------
+    std::vector<double> sortMs, sortedFwd, sortedBwd, oitFwd, oitBwd, ts;
+    std::vector<gs::GaussianParam> sorted;
+    for (uint32_t rep = 0; rep < cfg.warmup + cfg.reps; rep++) {
+        const bool keep = rep >= cfg.warmup;
+        for (gs::BlendMode blend : { gs::BLEND_SORTED, gs::BLEND_OIT }) {
+            if (blend == gs::BLEND_SORTED) {
+                double t0 = nowMs();
+                sorted = gs::sortByDepth(gaussians);
+                if (keep) sortMs.push_back(nowMs() - t0);
+                gs::uploadToBuffer(device, bufs.params, sorted.data(), paramsSize);
+            } else {
+                gs::uploadToBuffer(device, bufs.params, gaussians.data(), paramsSize);
+            }
+            gs::uploadToBuffer(device, bufs.grads, zeroGrads.data(), gradsSize);
+            submit([&] {
+                gs::recordTimestampReset(cmd, timer);
+                gs::recordTimestamp(cmd, timer, 0);
+                gs::recordForward(cmd, pipes, renderPC, blend);
+                gs::recordTimestamp(cmd, timer, 1);
+                gs::recordComputeBarrier(cmd);
+                gs::recordLoss(cmd, pipes, lossPC);
+                gs::recordTimestamp(cmd, timer, 2);
+                gs::recordComputeBarrier(cmd);
+                gs::recordBackward(cmd, pipes, renderPC, blend);
+                gs::recordTimestamp(cmd, timer, 3);
+            });
+            if (keep && gs::readTimestampsMs(device, timer, ts)) {
+                (blend == gs::BLEND_SORTED ? sortedFwd : oitFwd).push_back(ts[1] - ts[0]);
+                (blend == gs::BLEND_SORTED ? sortedBwd : oitBwd).push_back(ts[3] - ts[2]);
+            }
+        }
+    }
+
+    // ---------- 오차: 같은 (정렬된) 배열로 두 경로 ----------
+    std::vector<gs::GaussianGrad> grads[2];
+    std::vector<float> pixelLoss(pixelCount);
+    double totalLoss[2] = { 0, 0 };
+    for (int k = 0; k < 2; k++) {
+        const gs::BlendMode blend = k ? gs::BLEND_OIT : gs::BLEND_SORTED;
+        gs::uploadToBuffer(device, bufs.params, sorted.data(), paramsSize);
+        gs::uploadToBuffer(device, bufs.grads, zeroGrads.data(), gradsSize);
+        submit([&] { gs::recordTrainStep(cmd, pipes, bufs, renderPC, lossPC, blend); });
+        gs::downloadFromBuffer(device, bufs.rendered, (k ? imageOit : imageSorted).data(), imageSize);
+        gs::downloadFromBuffer(device, bufs.loss, pixelLoss.data(), pixelCount * sizeof(float));
+        for (float l : pixelLoss) totalLoss[k] += l;
+        gs::readGradients(device, bufs, N, grads[k]);
+    }
+
+    OitRow o;
+    o.gaussians = N; o.width = W; o.height = H;
+    double se = 0;
+    for (uint32_t i = 0; i < pixelCount; i++) {
+        glm::vec3 d = glm::vec3(imageOit[i]) - glm::vec3(imageSorted[i]);
+        se += double(d.x) * d.x + double(d.y) * d.y + double(d.z) * d.z;
+        o.maxAbs = std::max({ o.maxAbs, double(std::fabs(d.x)), double(std::fabs(d.y)), double(std::fabs(d.z)) });
+    }
+    const double mse = se / (3.0 * pixelCount);
+    o.rmse = std::sqrt(mse);
+    o.psnr = mse > 0 ? 10.0 * std::log10(1.0 / mse) : 99.0;
+    o.lossSorted = totalLoss[0];
+    o.lossOit = totalLoss[1];
+    std::vector<double> color[2], pos[2];
+    for (int k = 0; k < 2; k++) {
+        for (const gs::GaussianGrad& g : grads[k]) {
+            color[k].insert(color[k].end(), { g.dColor.x, g.dColor.y, g.dColor.z });
+            pos[k].insert(pos[k].end(), { g.dPosition.x, g.dPosition.y });
+        }
+    }
+    o.cosColor = cosine(color[0], color[1]);
+    o.cosPos   = cosine(pos[0], pos[1]);
+    o.sortMs      = computeStats(sortMs).median;
+    o.sortedFwdMs = computeStats(sortedFwd).median;
+    o.sortedBwdMs = computeStats(sortedBwd).median;
+    o.oitFwdMs    = computeStats(oitFwd).median;
+    o.oitBwdMs    = computeStats(oitBwd).median;
+    oitRows.push_back(o);
+
+    auto push = [&](const char* stage, std::vector<double>& samples) {
+        ResultRow r;
+        r.backend = "vulkan"; r.gaussians = N; r.width = W; r.height = H;
+        r.stage = stage; r.grad = "atomic"; r.samplesMs = samples;
+        if (samples.empty()) { r.skipped = true; r.reason = "timestamps unsupported"; }
+        rows.push_back(r);
+    };
+    push("depth_sort", sortMs);
+    push("sorted_forward", sortedFwd);
+    push("sorted_backward", sortedBwd);
+    push("oit_forward", oitFwd);
+    push("oit_backward", oitBwd);
+
+    gs::destroyBuffer(device, targetBuf);
+    gs::destroyTrainBuffers(device, bufs);
+}
+
+// ------------------------------------------------------------
+// 융합 step 비교: (N, W×H) 1개 조합
+// ------------------------------------------------------------
+// 매 rep: 분리 step 1회 + 융합 step 1회 (같은 파라미터, SGD 적용 안 함)
+//   step 시간 = 업로드 → 제출/대기 → loss/grads 다운로드 (분리 = 픽셀 loss, 융합 = 타일 loss)
+// 마지막에 grads 원본 (int) 비교 → 같은 식이므로 차이는 연산 순서/FMA 수준
+// ------------------------------------------------------------
+void runVulkanFusedConfig(
+    const BenchConfig& cfg,
+    gs::VkEngine& engine,
+    gs::TrainPipelines& pipes,
+    gs::TimestampPool& timer,
+    uint32_t N, uint32_t W, uint32_t H,
+    std::vector<ResultRow>& rows,
+    std::vector<FusedRow>& fusedRows
+) {
+    const uint32_t pixelCount = W * H;
+    const VkDeviceSize paramsSize = VkDeviceSize(N) * sizeof(gs::GaussianParam);
+    const VkDeviceSize gradsSize  = VkDeviceSize(N) * sizeof(gs::GaussianGradInt);
+    VkDevice device = engine.device();
+
+    std::vector<gs::GaussianParam> gaussians;
+    gs::TrainBuffers bufs = gs::createTrainBuffers(device, engine.physicalDevice(), N, W, H);
+    gs::BufferBundle targetBuf = prepareTrainScene(cfg, engine, pipes, bufs, N, W, H, gaussians);
+
+    VkCommandBuffer cmd = engine.commandBuffer();
+    gs::RenderPC renderPC{ W, H, N, 1.0f, gs::SAMPLE_NONE };
+    gs::LossPC lossPC{ W, H, cfg.ssimWeight, gs::SAMPLE_NONE };
+    gs::FusedPC fusedPC{ W, H, N, 1.0f, cfg.ssimWeight, 0 };
+    std::vector<gs::GaussianGradInt> zeroGrads(N, gs::GaussianGradInt{});
+    std::vector<gs::GaussianGradInt> gradsInt[2];
+    std::vector<float> pixelLoss(pixelCount);
+    double lastLoss[2] = { 0, 0 };
+
+    std::vector<double> sepGpu, fusedGpu, sepStep, fusedStep, ts;
+    for (uint32_t rep = 0; rep < cfg.warmup + cfg.reps; rep++) {
+        const bool keep = rep >= cfg.warmup;
+        for (int k = 0; k < 2; k++) {
+            const bool isFused = k == 1;
+            double t0 = nowMs();
+            gs::uploadToBuffer(device, bufs.params, gaussians.data(), paramsSize);
+            gs::uploadToBuffer(device, bufs.grads, zeroGrads.data(), gradsSize);
+
+            gs::beginOneTimeCommands(cmd);
+            gs::recordTimestampReset(cmd, timer);
+            gs::recordTimestamp(cmd, timer, 0);
+            if (isFused) {
+                gs::recordTrainStepFused(cmd, pipes, bufs, fusedPC);
+            } else {
+                gs::recordTrainStep(cmd, pipes, bufs, renderPC, lossPC);
+            }
+            gs::recordTimestamp(cmd, timer, 1);
+            vkEndCommandBuffer(cmd);
+            engine.submitAndWait(cmd);
+            vkResetCommandBuffer(cmd, 0);
+
+            double total = 0;
+            if (isFused) {
+                total = gs::readFusedLoss(device, bufs, W, H);
+            } else {
+                gs::downloadFromBuffer(device, bufs.loss, pixelLoss.data(), pixelCount * sizeof(float));
+                for (float l : pixelLoss) total += l;
+            }
+            gradsInt[k].resize(N);
+            gs::downloadFromBuffer(device, bufs.grads, gradsInt[k].data(), gradsSize);
+            lastLoss[k] = total;
+            double t1 = nowMs();
+
+            if (!keep) continue;
+            (isFused ? fusedStep : sepStep).push_back(t1 - t0);
+            if (gs::readTimestampsMs(device, timer, ts)) {
+                (isFused ? fusedGpu : sepGpu).push_back(ts[1] - ts[0]);
+            }
+        }
+    }
+
+    FusedRow f;
+    f.gaussians = N; f.width = W; f.height = H;
+    f.variant = cfg.ssimWeight > 0.0f ? "ssim" : "l1";
+    f.separateGpuMs  = computeStats(sepGpu).median;
+    f.fusedGpuMs     = computeStats(fusedGpu).median;
+    f.separateStepMs = computeStats(sepStep).median;
+    f.fusedStepMs    = computeStats(fusedStep).median;
+    f.lossRelDiff = lastLoss[0] != 0 ? std::fabs(lastLoss[1] - lastLoss[0]) / std::fabs(lastLoss[0]) : 0.0;
+    for (uint32_t i = 0; i < N; i++) {
+        const gs::GaussianGradInt& a = gradsInt[0][i];
+        const gs::GaussianGradInt& b = gradsInt[1][i];
+        for (int c = 0; c < 3; c++) {
+            f.gradMaxDiff = std::max<int64_t>(f.gradMaxDiff, std::llabs(int64_t(a.dColor[c]) - b.dColor[c]));
+        }
+        for (int c = 0; c < 2; c++) {
+            f.gradMaxDiff = std::max<int64_t>(f.gradMaxDiff, std::llabs(int64_t(a.dPosition[c]) - b.dPosition[c]));
+        }
+    }
+    // 타일마다 (타일 + halo) ∩ 이미지 영역을 렌더
+    const int64_t halo = cfg.ssimWeight > 0.0f ? 10 : 0;
+    int64_t rendered = 0;
+    for (int64_t ty = 0; ty < H; ty += gs::FUSED_TILE) {
+        for (int64_t tx = 0; tx < W; tx += gs::FUSED_TILE) {
+            int64_t x0 = std::max<int64_t>(0, tx - halo), x1 = std::min<int64_t>(W, tx + gs::FUSED_TILE + halo);
+            int64_t y0 = std::max<int64_t>(0, ty - halo), y1 = std::min<int64_t>(H, ty + gs::FUSED_TILE + halo);
+            rendered += (x1 - x0) * (y1 - y0);
+        }
+    }
+    f.renderOverdraw = double(rendered) / double(pixelCount);
+    fusedRows.push_back(f);
+
+    auto push = [&](const char* stage, std::vector<double>& samples) {
+        ResultRow r;
+        r.backend = "vulkan"; r.gaussians = N; r.width = W; r.height = H;
+        r.stage = stage; r.grad = "atomic"; r.samplesMs = samples;
+        if (samples.empty()) { r.skipped = true; r.reason = "timestamps unsupported"; }
+        rows.push_back(r);
+    };
+    push("separate_gpu", sepGpu);
+    push("fused_gpu", fusedGpu);
+    push("separate_step", sepStep);
+    push("fused_step", fusedStep);
+
+    gs::destroyBuffer(device, targetBuf);
+    gs::destroyTrainBuffers(device, bufs);
+}
+
+// ------------------------------------------------------------
+// 스케줄러: 조합마다 독립 학습 job 1개 (reps step), 순차 → 동시 순서로 2회
+// ------------------------------------------------------------
+// job마다 TrainPipelines 복사본 (pipeline 핸들 공유, binding 표만 job 전용)
+// 두 실행 모두 같은 초기 파라미터에서 시작
+// ------------------------------------------------------------
+struct SchedJob {
+    uint32_t N = 0, W = 0, H = 0;
+    int32_t  priority = 0;
+    gs::TrainPipelines pipes;
+    gs::TrainBuffers   bufs;
+    gs::BufferBundle   target;
+    std::vector<gs::GaussianParam> initial, gaussians;
+    std::vector<gs::GaussianGradInt> zeroGrads;
+    std::vector<gs::GaussianGrad> grads;
+    std::vector<float> pixelLoss;
+    std::vector<glm::vec3> dColor;
+    std::vector<glm::vec2> dPos;
+};
+
+gs::JobDesc makeTrainJob(const BenchConfig& cfg, VkDevice device, SchedJob& job) {
+    gs::JobDesc desc;
+    desc.name = "N" + std::to_string(job.N) + "_" + std::to_string(job.W) + "x" + std::to_string(job.H);
+    desc.priority = job.priority;
+    desc.record = [&cfg, device, &job](VkCommandBuffer cmd, uint32_t) {
+        gs::uploadToBuffer(device, job.bufs.params, job.gaussians.data(),
+            job.gaussians.size() * sizeof(gs::GaussianParam));
+        gs::uploadToBuffer(device, job.bufs.grads, job.zeroGrads.data(),
+            job.zeroGrads.size() * sizeof(gs::GaussianGradInt));
+        gs::RenderPC renderPC{ job.W, job.H, job.N, 1.0f, gs::SAMPLE_NONE };
+        gs::LossPC lossPC{ job.W, job.H, cfg.ssimWeight, gs::SAMPLE_NONE };
+        gs::recordTrainStep(cmd, job.pipes, job.bufs, renderPC, lossPC);
+    };
+    desc.finish = [&cfg, device, &job](uint32_t step) {
+        gs::downloadFromBuffer(device, job.bufs.loss, job.pixelLoss.data(),
+            job.pixelLoss.size() * sizeof(float));
+        gs::readGradients(device, job.bufs, job.N, job.grads);
+        for (uint32_t i = 0; i < job.N; i++) {
+            job.dColor[i] = job.grads[i].dColor;
+            job.dPos[i]   = glm::vec2(job.grads[i].dPosition);
+        }
+        applySGD(job.gaussians, job.dColor, job.dPos, job.W * job.H);
+        return step + 1 < cfg.reps;
+    };
+    return desc;
+}
+
+void runScheduled(const BenchConfig& cfg, gs::VkEngine& engine, gs::TrainPipelines& pipes, SchedReport& report) {
+    std::vector<std::unique_ptr<SchedJob>> jobs;
+    for (uint32_t res : cfg.resolutions) {
+        for (uint32_t N : cfg.counts) {
+            if (double(res) * res * N > cfg.maxWork) continue;
+            auto job = std::make_unique<SchedJob>();
+            job->N = N; job->W = res; job->H = res;
+            job->pipes = pipes;
+            job->bufs = gs::createTrainBuffers(engine.device(), engine.physicalDevice(), N, res, res);
+            job->target = prepareTrainScene(cfg, engine, job->pipes, job->bufs, N, res, res, job->initial);
+            job->zeroGrads.assign(N, gs::GaussianGradInt{});
+            job->pixelLoss.resize(size_t(res) * res);
+            job->dColor.resize(N);
+            job->dPos.resize(N);
+            jobs.push_back(std::move(job));
+        }
+    }
+    if (jobs.empty()) return;
+
+    // 작업량 작은 조합 = 높은 priority
+    std::vector<size_t> order(jobs.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return double(jobs[a]->W) * jobs[a]->H * jobs[a]->N < double(jobs[b]->W) * jobs[b]->H * jobs[b]->N;
+    });
+    for (size_t rank = 0; rank < order.size(); rank++) {
+        jobs[order[rank]]->priority = int32_t(order.size() - rank);
+    }
+
+    gs::SchedulerConfig schedCfg;
+    schedCfg.workers = cfg.schedWorkers;
+    schedCfg.policy  = cfg.schedPolicy;
+
+    for (int concurrent = 0; concurrent < 2; concurrent++) {
+        for (auto& job : jobs) job->gaussians = job->initial;
+        gs::JobScheduler scheduler;
+        scheduler.init(engine, schedCfg);
+        double t0 = nowMs();
+        for (auto& job : jobs) {
+            scheduler.submitJob(makeTrainJob(cfg, engine.device(), *job));
+            if (!concurrent) scheduler.waitAll();
+        }
+        scheduler.waitAll();
+        double wall = nowMs() - t0;
+
+        if (concurrent) {
+            report.concurrentMs = wall;
+            std::vector<gs::JobStats> stats = scheduler.stats();
+            for (size_t i = 0; i < jobs.size(); i++) {
+                SchedJobRow row;
+                row.gaussians = jobs[i]->N; row.width = jobs[i]->W; row.height = jobs[i]->H;
+                row.priority = stats[i].priority;
+                row.steps = stats[i].steps;
+                row.totalMs = stats[i].endMs - stats[i].startMs;
+                row.waitMs = stats[i].waitMs;
+                row.gpuMs = stats[i].gpuMs;
+                row.stepMs = stats[i].stepMs;
+                row.queueSubmits = stats[i].queueSubmits;
+                report.jobs.push_back(row);
+            }
+        } else {
+            report.sequentialMs = wall;
+        }
+        scheduler.shutdown();
+    }
+    report.ran = true;
+    report.workers = cfg.schedWorkers ? cfg.schedWorkers : std::max(1u, std::thread::hardware_concurrency());
+    report.queues = uint32_t(engine.computeQueues().size());
+    report.policy = (cfg.schedPolicy == gs::SchedulePolicy::Priority) ? "priority" : "rr";
+
+    for (auto& job : jobs) {
+        gs::destroyBuffer(engine.device(), job->target);
+        gs::destroyTrainBuffers(engine.device(), job->bufs);
+    }
+}
+
+// ------------------------------------------------------------
+// CPU 레퍼런스: (N, W×H) 1개 조합 측정
+// ------------------------------------------------------------
+void runCpuConfig(
+    const BenchConfig& cfg,
+    uint32_t N, uint32_t W, uint32_t H,
+    std::vector<ResultRow>& rows
+) {
+    const uint32_t pixelCount = W * H;
+    gs::SceneGenConfig sceneCfg = cfg.scene;
+    sceneCfg.count = N; sceneCfg.width = W; sceneCfg.height = H;
+    std::vector<gs::GaussianParam> gaussians = gs::generateScene(sceneCfg);
+    sceneCfg.seed += 1;
+    std::vector<gs::GaussianParam> targetScene = gs::generateScene(sceneCfg);
+
+    std::vector<glm::vec4> target(pixelCount), rendered(pixelCount), dLdR;
+    std::vector<float> pixelLoss;
+    std::vector<gs::GaussianGrad> grads;
+    std::vector<glm::vec3> dColor(N);
+    std::vector<glm::vec2> dPos(N);
+    gs::renderGaussiansCPU(target, targetScene, W, H);
+
+    std::vector<double> fwd, loss, bwd, step;
+    for (uint32_t rep = 0; rep < cfg.warmup + cfg.reps; rep++) {
+        double t0 = nowMs();
+        gs::renderGaussiansCPU(rendered, gaussians, W, H);
+        double t1 = nowMs();
+        gs::lossCPU(pixelLoss, dLdR, rendered, target, W, H, cfg.ssimWeight);
+        double t2 = nowMs();
+        gs::backwardCPU(grads, gaussians, dLdR, W, H);
+        double t3 = nowMs();
+        for (uint32_t i = 0; i < N; i++) {
+            dColor[i] = grads[i].dColor;
+            dPos[i]   = glm::vec2(grads[i].dPosition);
+        }
+        applySGD(gaussians, dColor, dPos, pixelCount);
+        double t4 = nowMs();
+
+        if (rep < cfg.warmup) continue;
+        fwd.push_back(t1 - t0);
+        loss.push_back(t2 - t1);
+        bwd.push_back(t3 - t2);
+        step.push_back(t4 - t0);
+    }
+
+    const char* stages[] = { "forward", "loss", "backward", "step" };
+    std::vector<double>* samples[] = { &fwd, &loss, &bwd, &step };
+    for (int s = 0; s < 4; s++) {
+        ResultRow r;
+        r.backend = "cpu"; r.gaussians = N; r.width = W; r.height = H;
+        r.stage = stages[s]; r.samplesMs = *samples[s];
+        rows.push_back(r);
+    }
+}
+
+void pushSkipped(std::vector<ResultRow>& rows, const char* backend, const char* grad,
+                 uint32_t N, uint32_t W, uint32_t H, const std::string& reason) {
+    for (const char* stage : { "forward", "loss", "backward", "step" }) {
+        ResultRow r;
+        r.backend = backend; r.gaussians = N; r.width = W; r.height = H;
+        r.stage = stage; r.grad = grad; r.skipped = true; r.reason = reason;
+        rows.push_back(r);
+    }
+}
+
+// ------------------------------------------------------------
+// JSON 출력 (외부 라이브러리 없이 fprintf)
+// ------------------------------------------------------------
+bool writeJson(const BenchConfig& cfg, const std::string& deviceName, const char* descriptorMode,
+               const std::vector<ResultRow>& rows, const std::vector<CounterRow>& counterRows,
+               const SchedReport& sched, const std::vector<OitRow>& oitRows,
+               const std::vector<FusedRow>& fusedRows) {
+    FILE* f = std::fopen(cfg.outPath.c_str(), "w");
+    if (!f) {
+        printf("[Error] Cannot open %s\n", cfg.outPath.c_str());
+        return false;
+    }
+    char timeStr[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(timeStr, sizeof(timeStr), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    std::fprintf(f, "{\n");
+    std::fprintf(f, "  \"schema\": 1,\n");
+    std::fprintf(f, "  \"timestamp\": \"%s\",\n", gs::jsonEscape(timeStr).c_str());
+    std::fprintf(f, "  \"device\": \"%s\",\n", gs::jsonEscape(deviceName).c_str());
+    std::fprintf(f, "  \"config\": {\n");
+    std::fprintf(f, "    \"warmup\": %u,\n", cfg.warmup);
+    std::fprintf(f, "    \"repetitions\": %u,\n", cfg.reps);
+    std::fprintf(f, "    \"ssim_weight\": %g,\n", cfg.ssimWeight);
+    std::fprintf(f, "    \"descriptors\": \"%s\",\n", gs::jsonEscape(descriptorMode).c_str());
+    std::fprintf(f, "    \"seed\": %u,\n", cfg.scene.seed);
+    std::fprintf(f, "    \"scale\": { \"dist\": \"%s\", \"min\": %g, \"max\": %g },\n",
+        gs::jsonEscape(distName(cfg.scene.scaleDist)).c_str(), cfg.scene.scaleMin, cfg.scene.scaleMax);
+    std::fprintf(f, "    \"opacity\": { \"dist\": \"%s\", \"min\": %g, \"max\": %g }\n",
+        gs::jsonEscape(distName(cfg.scene.opacityDist)).c_str(), cfg.scene.opacityMin, cfg.scene.opacityMax);
+    std::fprintf(f, "  },\n");
+    std::fprintf(f, "  \"results\": [\n");
+    for (size_t i = 0; i < rows.size(); i++) {
+        const ResultRow& r = rows[i];
+        std::fprintf(f, "    { \"backend\": \"%s\", \"gaussians\": %u, \"width\": %u, \"height\": %u, "
+            "\"stage\": \"%s\", ", gs::jsonEscape(r.backend).c_str(), r.gaussians, r.width, r.height,
+            gs::jsonEscape(r.stage).c_str());
+        if (!r.grad.empty()) std::fprintf(f, "\"grad\": \"%s\", ", gs::jsonEscape(r.grad).c_str());
+        if (r.scenes > 1) std::fprintf(f, "\"scenes\": %u, ", r.scenes);
+        if (r.reproducible >= 0) std::fprintf(f, "\"reproducible\": %s, ", r.reproducible ? "true" : "false");
+        if (r.reproducibleSampled >= 0) {
+            std::fprintf(f, "\"reproducible_sampled\": %s, ", r.reproducibleSampled ? "true" : "false");
+        }
+        if (r.skipped) {
+            std::fprintf(f, "\"skipped\": true, \"reason\": \"%s\" }", gs::jsonEscape(r.reason).c_str());
+        } else {
+            Stats s = computeStats(r.samplesMs);
+            double mpixPerSec = (s.median > 0) ? (double(r.width) * r.height * r.scenes / 1e6) / (s.median / 1e3) : 0.0;
+            std::fprintf(f, "\"unit\": \"ms\", \"samples\": %zu, \"mean\": %.6f, \"stddev\": %.6f, "
+                "\"min\": %.6f, \"median\": %.6f, \"max\": %.6f, \"mpix_per_s\": %.3f }",
+                r.samplesMs.size(), s.mean, s.stddev, s.min, s.median, s.max, mpixPerSec);
+        }
+        std::fprintf(f, "%s\n", (i + 1 < rows.size()) ? "," : "");
+    }
+    std::fprintf(f, "  ]");
+    if (!counterRows.empty()) {
+        std::fprintf(f, ",\n  \"counters\": [\n");
+        for (size_t i = 0; i < counterRows.size(); i++) {
+            const CounterRow& r = counterRows[i];
+            const gs::CounterSummary& s = r.summary;
+            std::fprintf(f, "    { \"gaussians\": %u, \"width\": %u, \"height\": %u, \"pass\": \"%s\", "
+                "\"blocks\": %u, \"evaluated\": %llu, \"significant\": %llu, \"early_term\": %llu, "
+                "\"atomics\": %llu, \"wasted\": %.6f, \"imbalance\": %.4f, \"max_eval_per_px\": %.3f, "
+                "\"histogram\": [", r.gaussians, r.width, r.height, gs::jsonEscape(r.pass).c_str(), s.activeBlocks,
+                (unsigned long long)s.evaluated, (unsigned long long)s.significant,
+                (unsigned long long)s.earlyTerm, (unsigned long long)s.atomics,
+                s.wastedFraction, s.imbalance, s.maxPerPixel);
+            for (size_t b = 0; b < s.histogram.size(); b++) {
+                std::fprintf(f, "%s%u", b ? ", " : "", s.histogram[b]);
+            }
+            std::fprintf(f, "] }%s\n", (i + 1 < counterRows.size()) ? "," : "");
+        }
+        std::fprintf(f, "  ]");
+    }
+    if (sched.ran) {
+        std::fprintf(f, ",\n  \"scheduler\": {\n");
+        std::fprintf(f, "    \"workers\": %u, \"queues\": %u, \"policy\": \"%s\",\n",
+            sched.workers, sched.queues, gs::jsonEscape(sched.policy).c_str());
+        std::fprintf(f, "    \"sequential_ms\": %.3f, \"concurrent_ms\": %.3f, \"speedup\": %.3f,\n",
+            sched.sequentialMs, sched.concurrentMs,
+            sched.concurrentMs > 0 ? sched.sequentialMs / sched.concurrentMs : 0.0);
+        std::fprintf(f, "    \"jobs\": [\n");
+        for (size_t i = 0; i < sched.jobs.size(); i++) {
+            const SchedJobRow& r = sched.jobs[i];
+            Stats w = computeStats(r.waitMs), g = computeStats(r.gpuMs), st = computeStats(r.stepMs);
+            std::fprintf(f, "      { \"gaussians\": %u, \"width\": %u, \"height\": %u, \"priority\": %d, "
+                "\"steps\": %u, \"total_ms\": %.3f, \"wait_median\": %.6f, \"gpu_median\": %.6f, "
+                "\"step_median\": %.6f, \"step_max\": %.6f, \"queue_submits\": [",
+                r.gaussians, r.width, r.height, r.priority, r.steps, r.totalMs,
+                w.median, g.median, st.median, st.max);
+            for (size_t q = 0; q < r.queueSubmits.size(); q++) {
+                std::fprintf(f, "%s%u", q ? ", " : "", r.queueSubmits[q]);
+            }
+            std::fprintf(f, "] }%s\n", (i + 1 < sched.jobs.size()) ? "," : "");
+        }
+        std::fprintf(f, "    ]\n  }");
+    }
+    if (!oitRows.empty()) {
+        // speedup_forward = (정렬 + 정렬 forward) / OIT forward
+        // speedup_step    = (정렬 + 정렬 forward + backward) / (OIT forward + backward)
+        std::fprintf(f, ",\n  \"oit\": [\n");
+        for (size_t i = 0; i < oitRows.size(); i++) {
+            const OitRow& o = oitRows[i];
+            const double sortedStep = o.sortMs + o.sortedFwdMs + o.sortedBwdMs;
+            const double oitStep = o.oitFwdMs + o.oitBwdMs;
+            std::fprintf(f, "    { \"gaussians\": %u, \"width\": %u, \"height\": %u, "
+                "\"sort_ms\": %.6f, \"sorted_forward_ms\": %.6f, \"sorted_backward_ms\": %.6f, "
+                "\"oit_forward_ms\": %.6f, \"oit_backward_ms\": %.6f, "
+                "\"speedup_forward\": %.4f, \"speedup_step\": %.4f, "
+                "\"rmse\": %.6f, \"max_abs\": %.6f, \"psnr\": %.3f, "
+                "\"loss_sorted\": %.6f, \"loss_oit\": %.6f, \"cos_dcolor\": %.6f, \"cos_dpos\": %.6f }%s\n",
+                o.gaussians, o.width, o.height,
+                o.sortMs, o.sortedFwdMs, o.sortedBwdMs, o.oitFwdMs, o.oitBwdMs,
+                o.oitFwdMs > 0 ? (o.sortMs + o.sortedFwdMs) / o.oitFwdMs : 0.0,
+                oitStep > 0 ? sortedStep / oitStep : 0.0,
+                o.rmse, o.maxAbs, o.psnr, o.lossSorted, o.lossOit, o.cosColor, o.cosPos,
+                (i + 1 < oitRows.size()) ? "," : "");
+        }
+        std::fprintf(f, "  ]");
+    }
+    if (!fusedRows.empty()) {
+        std::fprintf(f, ",\n  \"fused\": [\n");
+        for (size_t i = 0; i < fusedRows.size(); i++) {
+            const FusedRow& r = fusedRows[i];
+            std::fprintf(f, "    { \"gaussians\": %u, \"width\": %u, \"height\": %u, \"variant\": \"%s\", "
+                "\"separate_gpu_ms\": %.6f, \"fused_gpu_ms\": %.6f, \"speedup_gpu\": %.4f, "
+                "\"separate_step_ms\": %.6f, \"fused_step_ms\": %.6f, \"speedup_step\": %.4f, "
+                "\"loss_rel_diff\": %.3e, \"grad_max_diff\": %lld, \"render_overdraw\": %.4f }%s\n",
+                r.gaussians, r.width, r.height, gs::jsonEscape(r.variant).c_str(),
+                r.separateGpuMs, r.fusedGpuMs, r.fusedGpuMs > 0 ? r.separateGpuMs / r.fusedGpuMs : 0.0,
+                r.separateStepMs, r.fusedStepMs, r.fusedStepMs > 0 ? r.separateStepMs / r.fusedStepMs : 0.0,
+                r.lossRelDiff, (long long)r.gradMaxDiff, r.renderOverdraw,
+                (i + 1 < fusedRows.size()) ? "," : "");
+        }
+        std::fprintf(f, "  ]");
+    }
+    std::fprintf(f, "\n}\n");
+    std::fclose(f);
+    printf("[OK] Saved %s (%zu rows)\n", cfg.outPath.c_str(), rows.size());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchConfig cfg;
+    try {
+        cfg = parseArgs(argc, argv);
+    } catch (const std::exception& e) {
+        printf("[Error] %s\n", e.what());
+        printUsage();
+        return 1;
+    }
+
+    std::vector<ResultRow> rows;
+    std::vector<CounterRow> counterRows;
+    std::vector<OitRow> oitRows;
+    std::vector<FusedRow> fusedRows;
+    std::string deviceName = "none";
+    const char* descriptorMode = "none";
+
+    gs::VkEngine engine;
+    gs::TrainPipelines pipes{};
+    gs::TrainPipelines counterPipes{};
+    gs::TrainPipelines batchPipes{};
+    const bool batch = cfg.runGpu && cfg.batchScenes > 0;
+    const bool counters = cfg.runGpu && !cfg.countersDir.empty();
+    gs::TimestampPool timer{};
+    if (cfg.runGpu) {
+        engine.init(nullptr, cfg.device.empty() ? nullptr : cfg.device.c_str(), cfg.pushDescriptors,
+            cfg.computeQueues);
+        deviceName = engine.deviceName();
+        descriptorMode = engine.descriptors().pushDescriptors ? "push" : "pool";
+        printf("\n=== Create Pipelines ===\n");
+        pipes = gs::createTrainPipelines(engine, cfg.shaderDir);
+        if (counters) counterPipes = gs::createTrainPipelines(engine, cfg.shaderDir, true);
+        if (batch) batchPipes = gs::createTrainPipelines(engine, cfg.shaderDir, false, true);
+        timer = gs::createTimestampPool(engine.device(), engine.physicalDevice(),
+            engine.computeQueueFamily(), 4);
+    }
+
+    printf("\n=== Benchmark (warmup %u, reps %u) ===\n", cfg.warmup, cfg.reps);
+    for (uint32_t res : cfg.resolutions) {
+        for (uint32_t N : cfg.counts) {
+            double work = double(res) * res * N;
+
+            for (size_t m = 0; cfg.runGpu && m < cfg.gradModes.size(); m++) {
+                const gs::GradMode mode = cfg.gradModes[m];
+                if (work > cfg.maxWork) {
+                    pushSkipped(rows, "vulkan", gradModeName(mode), N, res, res, "max-work");
+                    continue;
+                }
+                // 계측 step은 첫 번째 mode에서만 (forward 카운터는 mode와 무관)
+                runVulkanConfig(cfg, engine, pipes, (counters && m == 0) ? &counterPipes : nullptr,
+                    timer, mode, N, res, res, rows, counterRows);
+                const ResultRow& bwdRow = rows[rows.size() - 2];
+                Stats b = computeStats(bwdRow.samplesMs);
+                Stats s = computeStats(rows.back().samplesMs);
+                printf("  vulkan %-13s N=%-8u %4ux%-4u backward %.3f ms, step median %.3f ms%s\n",
+                    gradModeName(mode), N, res, res, b.median, s.median,
+                    bwdRow.reproducible == 1 ? " (reproducible)" : " (grads differ between runs)");
+                if (bwdRow.reproducibleSampled == 0) printf("    sampled step: grads differ between runs\n");
+            }
+            if (batch) {
+                const uint32_t S = cfg.batchScenes;
+                if (work * S > cfg.maxWork || S > gs::BATCH_MAX_SCENES) {
+                    for (const char* stage : { "batch_gpu", "batch_step" }) {
+                        ResultRow r;
+                        r.backend = "vulkan"; r.gaussians = N; r.width = res; r.height = res;
+                        r.stage = stage; r.grad = "atomic"; r.scenes = S;
+                        r.skipped = true; r.reason = "max-work";
+                        rows.push_back(r);
+                    }
+                } else {
+                    runVulkanBatchConfig(cfg, engine, batchPipes, timer, S, N, res, res, rows);
+                    Stats s = computeStats(rows.back().samplesMs);
+                    printf("  vulkan batch S=%-6u N=%-8u %4ux%-4u step median %.3f ms (%.4f ms/scene)\n",
+                        S, N, res, res, s.median, s.median / S);
+                }
+            }
+            if (cfg.runGpu && cfg.oit) {
+                // 정렬 + OIT 두 경로 → 작업량 2배
+                if (work * 2 > cfg.maxWork) {
+                    for (const char* stage : { "depth_sort", "sorted_forward", "sorted_backward",
+                                               "oit_forward", "oit_backward" }) {
+                        ResultRow r;
+                        r.backend = "vulkan"; r.gaussians = N; r.width = res; r.height = res;
+                        r.stage = stage; r.grad = "atomic"; r.skipped = true; r.reason = "max-work";
+                        rows.push_back(r);
+                    }
+                } else {
+                    runVulkanOitConfig(cfg, engine, pipes, timer, N, res, res, rows, oitRows);
+                    const OitRow& o = oitRows.back();
+                    printf("  vulkan oit     N=%-8u %4ux%-4u sort+fwd %.3f ms vs oit fwd %.3f ms, "
+                        "PSNR %.1f dB, cos(dColor) %.3f\n",
+                        N, res, res, o.sortMs + o.sortedFwdMs, o.oitFwdMs, o.psnr, o.cosColor);
+                }
+            }
+            if (cfg.runGpu && cfg.fused) {
+                // 분리 + 융합 두 경로, SSIM 변형은 halo 중복 렌더까지 고려
+                const char* reason = nullptr;
+                if (work * 2 > cfg.maxWork) reason = "max-work";
+                else if (cfg.ssimWeight > 0.0f && !pipes.fusedSsim) reason = "shared-memory";
+                if (reason != nullptr) {
+                    for (const char* stage : { "separate_gpu", "fused_gpu", "separate_step", "fused_step" }) {
+                        ResultRow r;
+                        r.backend = "vulkan"; r.gaussians = N; r.width = res; r.height = res;
+                        r.stage = stage; r.grad = "atomic"; r.skipped = true; r.reason = reason;
+                        rows.push_back(r);
+                    }
+                } else {
+                    runVulkanFusedConfig(cfg, engine, pipes, timer, N, res, res, rows, fusedRows);
+                    const FusedRow& r = fusedRows.back();
+                    printf("  vulkan fused   N=%-8u %4ux%-4u separate %.3f ms vs fused %.3f ms (x%.2f), "
+                        "overdraw %.2f, grad diff %lld\n",
+                        N, res, res, r.separateGpuMs, r.fusedGpuMs,
+                        r.fusedGpuMs > 0 ? r.separateGpuMs / r.fusedGpuMs : 0.0,
+                        r.renderOverdraw, (long long)r.gradMaxDiff);
+                }
+            }
+            if (cfg.runCpu) {
+                if (work > cfg.cpuMaxWork) {
+                    pushSkipped(rows, "cpu", "", N, res, res, "cpu-max-work");
+                } else {
+                    runCpuConfig(cfg, N, res, res, rows);
+                    Stats s = computeStats(rows.back().samplesMs);
+                    printf("  cpu    N=%-8u %4ux%-4u step median %.3f ms\n", N, res, res, s.median);
+                }
+            }
+        }
+    }
+
+    SchedReport sched;
+    if (cfg.runGpu && cfg.schedule) {
+        printf("\n=== Scheduler (sequential vs concurrent jobs) ===\n");
+        runScheduled(cfg, engine, pipes, sched);
+        if (sched.ran) {
+            printf("  %zu jobs, %u queue(s): sequential %.1f ms, concurrent %.1f ms (x%.2f)\n",
+                sched.jobs.size(), sched.queues, sched.sequentialMs, sched.concurrentMs,
+                sched.concurrentMs > 0 ? sched.sequentialMs / sched.concurrentMs : 0.0);
+        }
+    }
+
+    writeJson(cfg, deviceName, descriptorMode, rows, counterRows, sched, oitRows, fusedRows);
+
+    if (cfg.runGpu) {
+        gs::destroyTimestampPool(engine.device(), timer);
+        gs::destroyTrainPipelines(engine.device(), pipes);
+        if (counters) gs::destroyTrainPipelines(engine.device(), counterPipes);
+        if (batch) gs::destroyTrainPipelines(engine.device(), batchPipes);
+        engine.cleanup();
+    }
+    return 0;
+}
@@ -0,0 +1,210 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include "common/GaussianTypes.hpp"
+// ============================================================
+// 파일: src/common/CpuReference.hpp
+// 역할: gaussian.comp / loss.comp / backward.comp 의 CPU 레퍼런스
+//       (target 생성, GPU 결과 검증, bench의 CPU 기준선)
+// ============================================================
+//
+// 수식은 shader와 동일하게 유지할 것:
+//   - forward : front-to-back 알파 블렌딩, T < 0.001 조기 종료
+//   - loss    : (1-λ)·L1 + λ·(1-SSIM), 11×11 가우시안 윈도우, 0 padding
+//   - backward: dColor, dPosition.xy (float 누적, /픽셀수 정규화 전)
+// ============================================================
+
+namespace gs {
+
+// ------------------------------------------------------------
+// renderGaussiansCPU: gaussian.comp와 동일한 forward
+// ------------------------------------------------------------
+// pixelScale: 렌더 픽셀 1개 = full-res 픽셀 몇 개 (피라미드 level)
+// ------------------------------------------------------------
+inline void renderGaussiansCPU(
+    std::vector<glm::vec4>& pixels,
+    const std::vector<GaussianParam>& gaussians,
+    uint32_t width, uint32_t height,
+    float pixelScale = 1.0f
+) {
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            glm::vec2 pixelPos = (glm::vec2(float(x), float(y)) + 0.5f) * pixelScale;
+
+            glm::vec3 colorAccum(0.0f);
+            float T = 1.0f;
+
+            for (const auto& g : gaussians) {
+                glm::vec2 center(g.position.x, g.position.y);
+                glm::vec2 diff = pixelPos - center;
+                float r2 = glm::dot(diff, diff);
+                float sigma2 = g.scale.x * g.scale.x;
+                float gaussian = std::exp(-0.5f * r2 / sigma2);
+                float alpha = gaussian * g.opacity;
+
+                colorAccum += g.color * alpha * T;
+                T *= (1.0f - alpha);
+
+                if (T < 0.001f) break;
+            }
+
+            pixels[y * width + x] = glm::vec4(colorAccum, 1.0f);
+        }
+    }
+}
+
+// ------------------------------------------------------------
+// blurSeparableCPU: 11×11 가우시안 (σ=1.5), 이미지 밖 = 0
+// ------------------------------------------------------------
+inline void blurSeparableCPU(
+    std::vector<float>& out,
+    const std::vector<float>& in,
+    uint32_t width, uint32_t height
+) {
+    static const float W[11] = {
+        0.0010284f, 0.0075988f, 0.0360008f, 0.1093607f, 0.2130055f, 0.2660117f,
+        0.2130055f, 0.1093607f, 0.0360008f, 0.0075988f, 0.0010284f
+    };
+    const int w = int(width), h = int(height);
+    std::vector<float> tmp(in.size(), 0.0f);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            float sum = 0.0f;
+            for (int k = -5; k <= 5; k++) {
+                int sx = x + k;
+                if (sx >= 0 && sx < w) sum += W[k + 5] * in[y * w + sx];
+            }
+            tmp[y * w + x] = sum;
+        }
+    }
+    out.assign(in.size(), 0.0f);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            float sum = 0.0f;
+            for (int k = -5; k <= 5; k++) {
+                int sy = y + k;
+                if (sy >= 0 && sy < h) sum += W[k + 5] * tmp[sy * w + x];
+            }
+            out[y * w + x] = sum;
+        }
+    }
+}
+
+// ------------------------------------------------------------
+// lossCPU: loss.comp와 동일 (픽셀별 loss + dL/dRendered)
+// ------------------------------------------------------------
+inline void lossCPU(
+    std::vector<float>& pixelLoss,
+    std::vector<glm::vec4>& dLdR,
+    const std::vector<glm::vec4>& rendered,
+    const std::vector<glm::vec4>& target,
+    uint32_t width, uint32_t height,
+    float ssimWeight
+) {
+    const float C1 = 0.01f * 0.01f;
+    const float C2 = 0.03f * 0.03f;
+    const size_t n = size_t(width) * height;
+    const float lambda = ssimWeight;
+
+    pixelLoss.assign(n, 0.0f);
+    dLdR.assign(n, glm::vec4(0.0f));
+
+    std::vector<float> x(n), y(n), xx(n), yy(n), xy(n);
+    std::vector<float> mx, my, mxx, myy, mxy;
+    std::vector<float> A(n), B(n), C(n), gA, gB, gC;
+    std::vector<float> ssimSum(n, 0.0f);
+
+    for (int c = 0; c < 3; c++) {
+        for (size_t i = 0; i < n; i++) {
+            x[i]  = rendered[i][c];
+            y[i]  = target[i][c];
+            xx[i] = x[i] * x[i];
+            yy[i] = y[i] * y[i];
+            xy[i] = x[i] * y[i];
+        }
+        blurSeparableCPU(mx,  x,  width, height);
+        blurSeparableCPU(my,  y,  width, height);
+        blurSeparableCPU(mxx, xx, width, height);
+        blurSeparableCPU(myy, yy, width, height);
+        blurSeparableCPU(mxy, xy, width, height);
+
+        for (size_t i = 0; i < n; i++) {
+            float vx  = mxx[i] - mx[i] * mx[i];
+            float vy  = myy[i] - my[i] * my[i];
+            float cxy = mxy[i] - mx[i] * my[i];
+            float n1 = 2.0f * mx[i] * my[i] + C1;
+            float n2 = 2.0f * cxy + C2;
+            float d1 = mx[i] * mx[i] + my[i] * my[i] + C1;
+            float d2 = vx + vy + C2;
+            float S  = (n1 * n2) / (d1 * d2);
+
+            float dS_dmx  = (2.0f * my[i] * n2) / (d1 * d2) - S * 2.0f * mx[i] / d1;
+            float dS_dvx  = -S / d2;
+            float dS_dcxy = 2.0f * n1 / (d1 * d2);
+
+            A[i] = dS_dmx - 2.0f * mx[i] * dS_dvx - my[i] * dS_dcxy;
+            B[i] = 2.0f * dS_dvx;
+            C[i] = dS_dcxy;
+            ssimSum[i] += S;
+        }
+        blurSeparableCPU(gA, A, width, height);
+        blurSeparableCPU(gB, B, width, height);
+        blurSeparableCPU(gC, C, width, height);
+
+        for (size_t i = 0; i < n; i++) {
+            float d = x[i] - y[i];
+            float sgn = float((d > 0.0f) - (d < 0.0f));
+            float dSsim = gA[i] + x[i] * gB[i] + y[i] * gC[i];
+            dLdR[i][c] = (1.0f - lambda) / 3.0f * sgn - lambda / 3.0f * dSsim;
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        glm::vec3 d = glm::vec3(rendered[i]) - glm::vec3(target[i]);
+        float l1 = (std::fabs(d.r) + std::fabs(d.g) + std::fabs(d.b)) / 3.0f;
+        pixelLoss[i] = (1.0f - lambda) * l1 + lambda * (1.0f - ssimSum[i] / 3.0f);
+    }
+}
+
+// ------------------------------------------------------------
+// backwardCPU: backward.comp와 동일 (atomic 대신 float 누적)
+// ------------------------------------------------------------
+inline void backwardCPU(
+    std::vector<GaussianGrad>& grads,
+    const std::vector<GaussianParam>& gaussians,
+    const std::vector<glm::vec4>& dLdR,
+    uint32_t width, uint32_t height,
+    float pixelScale = 1.0f
+) {
+    grads.assign(gaussians.size(), GaussianGrad{});
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            glm::vec2 pixelPos = (glm::vec2(float(x), float(y)) + 0.5f) * pixelScale;
+            glm::vec3 dL_dR = glm::vec3(dLdR[y * width + x]);
+
+            float T = 1.0f;
+            for (size_t i = 0; i < gaussians.size(); i++) {
+                const GaussianParam& g = gaussians[i];
+                glm::vec2 diff = pixelPos - glm::vec2(g.position);
+                float r2 = glm::dot(diff, diff);
+                float sigma2 = g.scale.x * g.scale.x;
+                float gaussian = std::exp(-0.5f * r2 / sigma2);
+                float alpha = gaussian * g.opacity;
+
+                grads[i].dColor += dL_dR * alpha * T;
+
+                glm::vec2 dGauss_dCenter = gaussian * diff / sigma2;
+                float dL_dGauss = glm::dot(dL_dR, g.color) * g.opacity * T;
+                grads[i].dPosition.x += dL_dGauss * dGauss_dCenter.x;
+                grads[i].dPosition.y += dL_dGauss * dGauss_dCenter.y;
+
+                T *= (1.0f - alpha);
+                if (T < 0.001f) break;
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "common/GaussianTypes.hpp"
+// ============================================================
+// 파일: src/common/DepthSort.hpp
+// 역할: 가우시안 깊이 정렬 (BLEND_SORTED 경로의 전처리)
+// ============================================================
+//
+// gaussian.comp는 배열 순서 = front-to-back으로 합성 → 매 프레임 정렬 필요
+// 깊이 = position.z (작을수록 앞), 같은 깊이는 원래 순서 유지 (stable)
+// 키 (z, 원래 인덱스)만 정렬 후 한 번에 재배치 (64 byte 구조체 이동 최소화)
+// ============================================================
+
+namespace gs {
+
+// order[k] = 정렬 후 k번째 가우시안의 원래 인덱스
+inline void depthOrder(const std::vector<GaussianParam>& gaussians, std::vector<uint32_t>& order) {
+    order.resize(gaussians.size());
+    for (uint32_t i = 0; i < order.size(); i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return gaussians[a].position.z < gaussians[b].position.z;
+    });
+}
+
+inline std::vector<GaussianParam> sortByDepth(const std::vector<GaussianParam>& gaussians) {
+    std::vector<uint32_t> order;
+    depthOrder(gaussians, order);
+    std::vector<GaussianParam> sorted(gaussians.size());
+    for (size_t k = 0; k < order.size(); k++) sorted[k] = gaussians[order[k]];
+    return sorted;
+}
+
+}
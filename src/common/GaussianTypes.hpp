@@ -67,4 +67,33 @@ inline GaussianParam makeDefaultGaussian(glm::vec3 pos, glm::vec3 col) {
     };
 }
 
+// ------------------------------------------------------------
+// GaussianGrad: 파라미터별 gradient (GaussianParam과 동일 레이아웃)
+// ------------------------------------------------------------
+struct GaussianGrad {
+    glm::vec3 dPosition;
+    float     dOpacity;
+    glm::vec3 dScale;
+    float     _pad0;
+    glm::vec4 dRotation;
+    glm::vec3 dColor;
+    float     _pad1;
+};
+static_assert(sizeof(GaussianGrad) == 64, "GaussianGrad must be 64 bytes");
+
+// ------------------------------------------------------------
+// GaussianGradInt: backward.comp atomicAdd용 고정소수점 버전
+// ------------------------------------------------------------
+// float 값 * GRAD_SCALE → int 로 누적 (GLSL 450엔 float atomic 없음)
+// ------------------------------------------------------------
+struct GaussianGradInt {
+    glm::ivec3 dPosition;   int dOpacity;
+    glm::ivec3 dScale;      int _pad0;
+    glm::ivec4 dRotation;
+    glm::ivec3 dColor;      int _pad1;
+};
+static_assert(sizeof(GaussianGradInt) == 64, "GaussianGradInt must be 64 bytes");
+
+const float GRAD_SCALE = 1000000.0f;  // backward.comp의 SCALE과 일치
+
 }
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+// ============================================================
+// 파일: src/common/Parallel.hpp
+// 역할: host 쪽 단순 병렬 루프 (LOD 빌드, 압축 등 전처리용)
+// ============================================================
+//
+// [0, count)를 스레드 수만큼 연속 구간으로 나눠 fn(i) 호출
+// 구간 분할이 고정 → 스레드별 부분합을 쓰면 결과가 실행마다 동일
+// ============================================================
+
+namespace gs {
+
+inline uint32_t defaultThreadCount(uint32_t requested = 0) {
+    return requested ? requested : std::max(1u, std::thread::hardware_concurrency());
+}
+
+template <typename Fn>
+inline void parallelFor(uint32_t count, uint32_t threadCount, Fn&& fn) {
+    threadCount = std::max(1u, threadCount);
+    std::vector<std::thread> pool;
+    uint32_t per = (count + threadCount - 1) / threadCount;
+    for (uint32_t t = 0; t < threadCount && t * per < count; t++) {
+        pool.emplace_back([&, t]() {
+            for (uint32_t i = t * per; i < std::min(count, (t + 1) * per); i++) fn(i);
+        });
+    }
+    for (auto& th : pool) th.join();
+}
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include "common/GaussianTypes.hpp"
+// ============================================================
+// 파일: src/common/SceneGen.hpp
+// 역할: 합성 장면 생성 (벤치마크 / 스트레스 테스트용)
+// ============================================================
+//
+// N개 랜덤 가우시안을 이미지 영역 안에 뿌림
+// 좌표계 = full-res 픽셀 (gaussian.comp와 동일)
+//
+// 분포 선택:
+//   scale  : Uniform [min, max] 또는 LogUniform (작은 가우시안 다수, 큰 것 소수)
+//   opacity: Uniform [min, max] 또는 Constant (= opacityMax)
+//
+// 깊이 (position.z): depthMax > 0이면 Uniform [0, depthMax], 아니면 0
+//   별도 rng로 뽑음 → depthMax와 무관하게 xy/색/크기는 같은 장면
+//
+// 같은 seed → 같은 장면 (run 간 비교 가능)
+// ============================================================
+
+namespace gs {
+
+enum class Distribution {
+    Uniform,
+    LogUniform,
+    Constant,
+};
+
+struct SceneGenConfig {
+    uint32_t     count       = 1000;
+    uint32_t     width       = 64;      // 위치 범위 (픽셀)
+    uint32_t     height      = 64;
+    Distribution scaleDist   = Distribution::LogUniform;
+    float        scaleMin    = 1.0f;    // 픽셀 단위 반지름
+    float        scaleMax    = 16.0f;
+    Distribution opacityDist = Distribution::Uniform;
+    float        opacityMin  = 0.2f;
+    float        opacityMax  = 1.0f;
+    float        depthMax    = 0.0f;    // 0 = 모두 z = 0 (배열 순서 = 합성 순서)
+    uint32_t     seed        = 42;
+};
+
+inline float sampleDistribution(
+    std::mt19937& rng, Distribution dist, float lo, float hi
+) {
+    std::uniform_real_distribution<float> u01(0.0f, 1.0f);
+    switch (dist) {
+    case Distribution::Constant:
+        return hi;
+    case Distribution::LogUniform:
+        // log 공간에서 균등 → lo=1, hi=16이면 1~2, 2~4, 4~8, 8~16 구간 확률 동일
+        return lo * std::pow(hi / lo, u01(rng));
+    case Distribution::Uniform:
+    default:
+        return lo + (hi - lo) * u01(rng);
+    }
+}
+
+// ------------------------------------------------------------
+// generateScene: cfg에 따라 N개 가우시안 생성
+// ------------------------------------------------------------
+inline std::vector<GaussianParam> generateScene(const SceneGenConfig& cfg) {
+    std::mt19937 rng(cfg.seed);
+    std::mt19937 depthRng(cfg.seed ^ 0x9e3779b9u);
+    std::uniform_real_distribution<float> u01(0.0f, 1.0f);
+
+    std::vector<GaussianParam> scene;
+    scene.reserve(cfg.count);
+    for (uint32_t i = 0; i < cfg.count; i++) {
+        glm::vec3 pos(u01(rng) * float(cfg.width), u01(rng) * float(cfg.height), 0.0f);
+        glm::vec3 col(u01(rng), u01(rng), u01(rng));
+        GaussianParam g = makeDefaultGaussian(pos, col);
+        g.scale   = glm::vec3(sampleDistribution(rng, cfg.scaleDist, cfg.scaleMin, cfg.scaleMax));
+        g.opacity = sampleDistribution(rng, cfg.opacityDist, cfg.opacityMin, cfg.opacityMax);
+        if (cfg.depthMax > 0.0f) g.position.z = u01(depthRng) * cfg.depthMax;
+        scene.push_back(g);
+    }
+    return scene;
+}
+
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <cstdint>
+#include "common/GaussianTypes.hpp"
+// ============================================================
+// 파일: src/common/SceneIO.hpp
+// 역할: 학습된 장면 저장/로드 (.gsplat 바이너리)
+// ============================================================
+//
+// 레이아웃 (little-endian, GPU 버퍼에 그대로 업로드 가능):
+//   SceneFileHeader (32 bytes)
+//   GaussianParam[count] (64 bytes each, SSBO와 1:1)
+//
+// width/height = 학습 해상도 (장면 좌표 범위, full-res 픽셀)
+// ============================================================
+
+namespace gs {
+
+const uint32_t SCENE_FILE_MAGIC   = 0x4C505347;  // "GSPL"
+const uint32_t SCENE_FILE_VERSION = 1;
+
+struct SceneFileHeader {
+    uint32_t magic   = SCENE_FILE_MAGIC;
+    uint32_t version = SCENE_FILE_VERSION;
+    uint32_t count   = 0;
+    uint32_t width   = 0;
+    uint32_t height  = 0;
+    uint32_t _pad[3] = {};
+};
+
+static_assert(sizeof(SceneFileHeader) == 32, "SceneFileHeader must be 32 bytes");
+
+// ------------------------------------------------------------
+// Scene: 가우시안 + 좌표 범위
+// ------------------------------------------------------------
+struct Scene {
+    std::vector<GaussianParam> gaussians;
+    uint32_t width  = 0;
+    uint32_t height = 0;
+};
+
+inline bool saveScene(const std::string& filename, const Scene& scene) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        printf("[Error] Cannot open %s\n", filename.c_str());
+        return false;
+    }
+
+    SceneFileHeader header;
+    header.count  = uint32_t(scene.gaussians.size());
+    header.width  = scene.width;
+    header.height = scene.height;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(scene.gaussians.data()),
+        std::streamsize(scene.gaussians.size() * sizeof(GaussianParam)));
+
+    if (!file.good()) {
+        printf("[Error] Write failed: %s\n", filename.c_str());
+        return false;
+    }
+    printf("[OK] Saved %s (%u gaussians, %ux%u)\n",
+        filename.c_str(), header.count, header.width, header.height);
+    return true;
+}
+
+inline bool loadScene(const std::string& filename, Scene& scene) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        printf("[Error] Cannot open %s\n", filename.c_str());
+        return false;
+    }
+
+    SceneFileHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file.good() || header.magic != SCENE_FILE_MAGIC) {
+        printf("[Error] %s is not a .gsplat scene\n", filename.c_str());
+        return false;
+    }
+    if (header.version != SCENE_FILE_VERSION) {
+        printf("[Error] %s: unsupported version %u\n", filename.c_str(), header.version);
+        return false;
+    }
+
+    scene.gaussians.resize(header.count);
+    file.read(reinterpret_cast<char*>(scene.gaussians.data()),
+        std::streamsize(size_t(header.count) * sizeof(GaussianParam)));
+    if (!file.good()) {
+        printf("[Error] %s: truncated (expected %u gaussians)\n", filename.c_str(), header.count);
+        return false;
+    }
+    scene.width  = header.width;
+    scene.height = header.height;
+    return true;
+}
+
+}
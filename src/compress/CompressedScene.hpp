@@ -0,0 +1,304 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include "common/GaussianTypes.hpp"
+#include "common/SceneIO.hpp"
+#include "compress/KMeans.hpp"
+#include "lod/LodTree.hpp"
+// ============================================================
+// 파일: src/compress/CompressedScene.hpp
+// 역할: 압축 장면 (.gscomp) - codebook 양자화, shader에서 직접 디코드
+// ============================================================
+//
+// 가우시안 1개 = 8 bytes (GaussianParam 64 bytes 대비 1/8):
+//   position   : uint32 = x16 | y16 << 16   chunk 위치 AABB 기준 16-bit 고정소수점
+//   attributes : uint32 = opacity8 | scale8 << 8 | rotation8 << 16 | color8 << 24
+//                opacity = 8-bit 선형, 나머지 = 각 codebook(256개) 인덱스
+//
+// chunk = Morton 순 연속 chunkSize개 (ChunkFile과 같은 분할)
+//   → chunk AABB가 작아서 16-bit로도 위치 오차 ≈ chunk 크기 / 65535
+//
+// codebook (k-means, vec4 × 768):
+//   [0, 256)   scale    (log 공간에서 학습 → 작은/큰 가우시안 모두 상대 오차 균일)
+//   [256, 512) rotation (정규화 + w ≥ 0 로 부호 통일)
+//   [512, 768) color
+//
+// 렌더러가 2D라 position.z는 저장하지 않음 (디코드 시 0)
+// 블렌딩 순서 = Morton 순 (비교 기준은 decodeScene 순서의 원본)
+// ============================================================
+
+namespace gs {
+
+const uint32_t COMPRESSED_FILE_MAGIC   = 0x43505347;  // "GSPC"
+const uint32_t COMPRESSED_FILE_VERSION = 1;
+const uint32_t CODEBOOK_SIZE     = 256;
+const uint32_t CODEBOOK_SCALE    = 0;
+const uint32_t CODEBOOK_ROTATION = CODEBOOK_SIZE;
+const uint32_t CODEBOOK_COLOR    = CODEBOOK_SIZE * 2;
+const uint32_t CODEBOOK_ENTRIES  = CODEBOOK_SIZE * 3;
+
+struct CompressedFileHeader {
+    uint32_t magic      = COMPRESSED_FILE_MAGIC;
+    uint32_t version    = COMPRESSED_FILE_VERSION;
+    uint32_t count      = 0;
+    uint32_t chunkSize  = 0;
+    uint32_t chunkCount = 0;
+    uint32_t width      = 0;
+    uint32_t height     = 0;
+    uint32_t _pad       = 0;
+};
+
+static_assert(sizeof(CompressedFileHeader) == 32, "CompressedFileHeader must be 32 bytes");
+
+// render_views.comp packedGaussians[]와 1:1 (uvec2)
+struct CompressedGaussian {
+    uint32_t position;
+    uint32_t attributes;
+};
+
+static_assert(sizeof(CompressedGaussian) == 8, "CompressedGaussian must be 8 bytes");
+
+// render_views.comp packedChunks[]와 1:1 (vec4 = min.xy, max.xy)
+struct CompressedChunk {
+    glm::vec2 posMin;
+    glm::vec2 posMax;
+};
+
+static_assert(sizeof(CompressedChunk) == 16, "CompressedChunk must be 16 bytes");
+
+// ------------------------------------------------------------
+// CompressedScene: 파일 내용 그대로 (GPU 업로드도 그대로)
+// ------------------------------------------------------------
+// 파일 레이아웃: header → codebooks[768] → chunks[chunkCount] → gaussians[count]
+// ------------------------------------------------------------
+struct CompressedScene {
+    CompressedFileHeader            header;
+    std::vector<glm::vec4>          codebooks;   // CODEBOOK_ENTRIES
+    std::vector<CompressedChunk>    chunks;
+    std::vector<CompressedGaussian> gaussians;
+};
+
+struct CompressConfig {
+    uint32_t     chunkSize = 256;
+    KMeansConfig kmeans;
+};
+
+// ------------------------------------------------------------
+// CompressStats: 속성별 양자화 오차 (원본 대비)
+// ------------------------------------------------------------
+struct CompressStats {
+    double scaleRelErr    = 0.0;  // mean |s' - s| / s
+    double rotationErr    = 0.0;  // mean (1 - |q'·q|)
+    double colorRmse      = 0.0;
+    double opacityRmse    = 0.0;
+    double positionMaxErr = 0.0;  // 픽셀
+    double buildMs        = 0.0;
+};
+
+inline size_t compressedFileBytes(const CompressedScene& cs) {
+    return sizeof(CompressedFileHeader) + cs.codebooks.size() * sizeof(glm::vec4) +
+           cs.chunks.size() * sizeof(CompressedChunk) + cs.gaussians.size() * sizeof(CompressedGaussian);
+}
+
+// ------------------------------------------------------------
+// decodeGaussian: render_views.comp fetchGaussian과 같은 식 (CPU 검증/리포트용)
+// ------------------------------------------------------------
+inline GaussianParam decodeGaussian(const CompressedScene& cs, uint32_t i) {
+    const CompressedGaussian& q = cs.gaussians[i];
+    const CompressedChunk& chunk = cs.chunks[i / cs.header.chunkSize];
+    glm::vec2 t(float(q.position & 0xFFFFu) / 65535.0f, float(q.position >> 16) / 65535.0f);
+    glm::vec2 p = chunk.posMin + (chunk.posMax - chunk.posMin) * t;
+
+    GaussianParam g = makeDefaultGaussian(glm::vec3(p, 0.0f),
+        glm::vec3(cs.codebooks[CODEBOOK_COLOR + (q.attributes >> 24)]));
+    g.opacity  = float(q.attributes & 0xFFu) / 255.0f;
+    g.scale    = glm::vec3(cs.codebooks[CODEBOOK_SCALE + ((q.attributes >> 8) & 0xFFu)]);
+    g.rotation = cs.codebooks[CODEBOOK_ROTATION + ((q.attributes >> 16) & 0xFFu)];
+    return g;
+}
+
+inline std::vector<GaussianParam> decodeScene(const CompressedScene& cs) {
+    std::vector<GaussianParam> out(cs.gaussians.size());
+    for (uint32_t i = 0; i < out.size(); i++) out[i] = decodeGaussian(cs, i);
+    return out;
+}
+
+// ------------------------------------------------------------
+// compressScene: Morton 정렬 → chunk 위치 양자화 + codebook 3개 학습
+// ------------------------------------------------------------
+// sortedOut != nullptr 이면 Morton 순 원본 반환 (압축본과 같은 블렌딩 순서 → 품질 비교 기준)
+// ------------------------------------------------------------
+inline CompressStats compressScene(
+    const Scene& scene,
+    const CompressConfig& cfg,
+    CompressedScene& cs,
+    std::vector<GaussianParam>* sortedOut = nullptr
+) {
+    auto t0 = std::chrono::steady_clock::now();
+    CompressStats stats;
+    const uint32_t N = uint32_t(scene.gaussians.size());
+    const uint32_t chunkSize = std::max(1u, cfg.chunkSize);
+
+    std::vector<GaussianParam> sorted(N);
+    {
+        const std::vector<uint32_t> order = mortonOrder(scene.gaussians);
+        for (uint32_t i = 0; i < N; i++) sorted[i] = scene.gaussians[order[i]];
+    }
+
+    cs.header = CompressedFileHeader{};
+    cs.header.count      = N;
+    cs.header.chunkSize  = chunkSize;
+    cs.header.chunkCount = (N + chunkSize - 1) / chunkSize;
+    cs.header.width      = scene.width;
+    cs.header.height     = scene.height;
+
+    // ---------- chunk 위치 AABB ----------
+    cs.chunks.assign(cs.header.chunkCount, CompressedChunk{ glm::vec2(1e30f), glm::vec2(-1e30f) });
+    for (uint32_t i = 0; i < N; i++) {
+        CompressedChunk& c = cs.chunks[i / chunkSize];
+        c.posMin = glm::min(c.posMin, glm::vec2(sorted[i].position));
+        c.posMax = glm::max(c.posMax, glm::vec2(sorted[i].position));
+    }
+
+    // ---------- codebook 학습 ----------
+    std::vector<glm::vec4> scales(N), rotations(N), colors(N);
+    for (uint32_t i = 0; i < N; i++) {
+        const GaussianParam& g = sorted[i];
+        scales[i] = glm::vec4(glm::log(glm::max(g.scale, glm::vec3(1e-6f))), 0.0f);
+        glm::vec4 q = g.rotation;
+        float len = std::sqrt(glm::dot(q, q));
+        q = (len > 0.0f) ? q / len : glm::vec4(1, 0, 0, 0);
+        rotations[i] = (q.x < 0.0f) ? -q : q;  // rotation = (w, x, y, z)
+        colors[i] = glm::vec4(g.color, 0.0f);
+    }
+    KMeansResult scaleKM    = kmeans(scales, cfg.kmeans);
+    KMeansResult rotationKM = kmeans(rotations, cfg.kmeans);
+    KMeansResult colorKM    = kmeans(colors, cfg.kmeans);
+
+    cs.codebooks.assign(CODEBOOK_ENTRIES, glm::vec4(0.0f));
+    for (size_t c = 0; c < scaleKM.centers.size(); c++) {
+        cs.codebooks[CODEBOOK_SCALE + c] = glm::vec4(glm::exp(glm::vec3(scaleKM.centers[c])), 0.0f);
+    }
+    for (size_t c = 0; c < rotationKM.centers.size(); c++) {
+        glm::vec4 q = rotationKM.centers[c];
+        float len = std::sqrt(glm::dot(q, q));
+        cs.codebooks[CODEBOOK_ROTATION + c] = (len > 0.0f) ? q / len : glm::vec4(1, 0, 0, 0);
+    }
+    for (size_t c = 0; c < colorKM.centers.size(); c++) {
+        cs.codebooks[CODEBOOK_COLOR + c] = colorKM.centers[c];
+    }
+
+    // ---------- 가우시안 양자화 ----------
+    cs.gaussians.resize(N);
+    for (uint32_t i = 0; i < N; i++) {
+        const GaussianParam& g = sorted[i];
+        const CompressedChunk& c = cs.chunks[i / chunkSize];
+        glm::vec2 extent = c.posMax - c.posMin;
+        glm::vec2 t(extent.x > 0.0f ? (g.position.x - c.posMin.x) / extent.x : 0.0f,
+                    extent.y > 0.0f ? (g.position.y - c.posMin.y) / extent.y : 0.0f);
+        uint32_t qx = uint32_t(std::lround(glm::clamp(t.x, 0.0f, 1.0f) * 65535.0f));
+        uint32_t qy = uint32_t(std::lround(glm::clamp(t.y, 0.0f, 1.0f) * 65535.0f));
+        uint32_t op = uint32_t(std::lround(glm::clamp(g.opacity, 0.0f, 1.0f) * 255.0f));
+        cs.gaussians[i].position   = qx | (qy << 16);
+        cs.gaussians[i].attributes = op | (uint32_t(scaleKM.labels[i]) << 8) |
+            (uint32_t(rotationKM.labels[i]) << 16) | (uint32_t(colorKM.labels[i]) << 24);
+    }
+
+    // ---------- 오차 ----------
+    double colorSq = 0.0, opacitySq = 0.0;
+    for (uint32_t i = 0; i < N; i++) {
+        const GaussianParam& a = sorted[i];
+        GaussianParam b = decodeGaussian(cs, i);
+        glm::vec3 s = glm::max(a.scale, glm::vec3(1e-6f));
+        stats.scaleRelErr += double(glm::dot(glm::abs(b.scale - s) / s, glm::vec3(1.0f / 3.0f)));
+        stats.rotationErr += 1.0 - std::abs(double(glm::dot(rotations[i], b.rotation)));
+        glm::vec3 dc = b.color - a.color;
+        colorSq += double(glm::dot(dc, dc)) / 3.0;
+        double dop = double(b.opacity) - double(glm::clamp(a.opacity, 0.0f, 1.0f));
+        opacitySq += dop * dop;
+        glm::vec2 dp = glm::abs(glm::vec2(b.position) - glm::vec2(a.position));
+        stats.positionMaxErr = std::max(stats.positionMaxErr, double(std::max(dp.x, dp.y)));
+    }
+    if (N > 0) {
+        stats.scaleRelErr /= N;
+        stats.rotationErr /= N;
+        stats.colorRmse    = std::sqrt(colorSq / N);
+        stats.opacityRmse  = std::sqrt(opacitySq / N);
+    }
+    stats.buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    if (sortedOut) *sortedOut = std::move(sorted);
+    return stats;
+}
+
+inline bool saveCompressedScene(const std::string& filename, const CompressedScene& cs) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        printf("[Error] Cannot open %s\n", filename.c_str());
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&cs.header), sizeof(cs.header));
+    file.write(reinterpret_cast<const char*>(cs.codebooks.data()),
+        std::streamsize(cs.codebooks.size() * sizeof(glm::vec4)));
+    file.write(reinterpret_cast<const char*>(cs.chunks.data()),
+        std::streamsize(cs.chunks.size() * sizeof(CompressedChunk)));
+    file.write(reinterpret_cast<const char*>(cs.gaussians.data()),
+        std::streamsize(cs.gaussians.size() * sizeof(CompressedGaussian)));
+    if (!file.good()) {
+        printf("[Error] Write failed: %s\n", filename.c_str());
+        return false;
+    }
+    printf("[OK] Saved %s (%u gaussians, %.2f MB)\n",
+        filename.c_str(), cs.header.count, double(compressedFileBytes(cs)) / (1024.0 * 1024.0));
+    return true;
+}
+
+// ------------------------------------------------------------
+// loadCompressedScene: 배열 3개를 각각 read 1번 (디코드/변환 없음)
+// ------------------------------------------------------------
+inline bool loadCompressedScene(const std::string& filename, CompressedScene& cs) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        printf("[Error] Cannot open %s\n", filename.c_str());
+        return false;
+    }
+
+    file.read(reinterpret_cast<char*>(&cs.header), sizeof(cs.header));
+    if (!file.good() || cs.header.magic != COMPRESSED_FILE_MAGIC) {
+        printf("[Error] %s is not a .gscomp scene\n", filename.c_str());
+        return false;
+    }
+    if (cs.header.version != COMPRESSED_FILE_VERSION) {
+        printf("[Error] %s: unsupported version %u\n", filename.c_str(), cs.header.version);
+        return false;
+    }
+    if (cs.header.chunkSize == 0 ||
+        cs.header.chunkCount != (cs.header.count + cs.header.chunkSize - 1) / cs.header.chunkSize) {
+        printf("[Error] %s: inconsistent chunk layout\n", filename.c_str());
+        return false;
+    }
+
+    cs.codebooks.resize(CODEBOOK_ENTRIES);
+    cs.chunks.resize(cs.header.chunkCount);
+    cs.gaussians.resize(cs.header.count);
+    file.read(reinterpret_cast<char*>(cs.codebooks.data()),
+        std::streamsize(cs.codebooks.size() * sizeof(glm::vec4)));
+    file.read(reinterpret_cast<char*>(cs.chunks.data()),
+        std::streamsize(cs.chunks.size() * sizeof(CompressedChunk)));
+    file.read(reinterpret_cast<char*>(cs.gaussians.data()),
+        std::streamsize(cs.gaussians.size() * sizeof(CompressedGaussian)));
+    if (!file.good()) {
+        printf("[Error] %s: truncated (expected %u gaussians)\n", filename.c_str(), cs.header.count);
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include "common/Parallel.hpp"
+// ============================================================
+// 파일: src/compress/KMeans.hpp
+// 역할: codebook 학습용 k-means (최대 4차원, k ≤ 256 → 8-bit 인덱스)
+// ============================================================
+//
+// 1. 학습 표본: N개 중 최대 sampleCount개 (seed 고정)
+// 2. 초기화: k-means++ (표본 위에서)
+// 3. Lloyd 반복 (표본 위에서): 할당 병렬 → 스레드별 부분합 → 고정 순서로 합산
+// 4. 전체 N개 최종 할당 + MSE
+//
+// 스레드 분할이 고정이라 같은 입력/설정이면 결과 동일
+// 빈 cluster는 현재 오차가 가장 큰 표본으로 다시 시작
+// ============================================================
+
+namespace gs {
+
+struct KMeansConfig {
+    uint32_t k           = 256;
+    uint32_t iterations  = 12;
+    uint32_t sampleCount = 1u << 16;
+    uint32_t seed        = 7;
+    uint32_t threads     = 0;      // 0 = hardware_concurrency
+};
+
+struct KMeansResult {
+    std::vector<glm::vec4> centers;
+    std::vector<uint8_t>   labels;   // 점마다 center 인덱스
+    double                 mse = 0.0;
+};
+
+namespace detail {
+
+inline uint32_t nearestCenter(const glm::vec4& p, const std::vector<glm::vec4>& centers, float& bestDist) {
+    uint32_t best = 0;
+    bestDist = 3.4e38f;
+    for (uint32_t c = 0; c < centers.size(); c++) {
+        glm::vec4 d = p - centers[c];
+        float dist = glm::dot(d, d);
+        if (dist < bestDist) {
+            bestDist = dist;
+            best = c;
+        }
+    }
+    return best;
+}
+
+} // namespace detail
+
+inline KMeansResult kmeans(const std::vector<glm::vec4>& points, const KMeansConfig& cfg) {
+    KMeansResult result;
+    const uint32_t N = uint32_t(points.size());
+    if (N == 0) return result;
+    const uint32_t K = std::max(1u, std::min({ cfg.k, N, 256u }));
+    const uint32_t threadCount = defaultThreadCount(cfg.threads);
+    std::mt19937 rng(cfg.seed);
+
+    // ---------- 학습 표본 ----------
+    std::vector<glm::vec4> sample;
+    if (N <= cfg.sampleCount) {
+        sample = points;
+    } else {
+        sample.reserve(cfg.sampleCount);
+        std::uniform_int_distribution<uint32_t> pick(0, N - 1);
+        for (uint32_t i = 0; i < cfg.sampleCount; i++) sample.push_back(points[pick(rng)]);
+    }
+    const uint32_t S = uint32_t(sample.size());
+
+    // ---------- k-means++ 초기화 ----------
+    std::vector<glm::vec4>& centers = result.centers;
+    std::vector<float> dist(S, 3.4e38f);
+    centers.push_back(sample[std::uniform_int_distribution<uint32_t>(0, S - 1)(rng)]);
+    while (centers.size() < K) {
+        const glm::vec4 last = centers.back();
+        double total = 0.0;
+        for (uint32_t i = 0; i < S; i++) {
+            glm::vec4 d = sample[i] - last;
+            dist[i] = std::min(dist[i], glm::dot(d, d));
+            total += dist[i];
+        }
+        if (total <= 0.0) break;  // 서로 다른 값이 K개보다 적음
+        double r = std::uniform_real_distribution<double>(0.0, total)(rng);
+        uint32_t next = 0;
+        for (; next + 1 < S; next++) {
+            r -= dist[next];
+            if (r <= 0.0) break;
+        }
+        centers.push_back(sample[next]);
+    }
+    const uint32_t KC = uint32_t(centers.size());
+
+    // ---------- Lloyd 반복 ----------
+    std::vector<uint32_t> labels(S);
+    std::vector<float> err(S);
+    const uint32_t per = (S + threadCount - 1) / threadCount;
+    for (uint32_t it = 0; it < cfg.iterations; it++) {
+        std::vector<std::vector<glm::dvec4>> sums(threadCount, std::vector<glm::dvec4>(KC, glm::dvec4(0.0)));
+        std::vector<std::vector<uint32_t>> counts(threadCount, std::vector<uint32_t>(KC, 0));
+        parallelFor(threadCount, threadCount, [&](uint32_t t) {
+            for (uint32_t i = t * per; i < std::min(S, (t + 1) * per); i++) {
+                labels[i] = detail::nearestCenter(sample[i], centers, err[i]);
+                sums[t][labels[i]] += glm::dvec4(sample[i]);
+                counts[t][labels[i]]++;
+            }
+        });
+        for (uint32_t c = 0; c < KC; c++) {
+            glm::dvec4 sum(0.0);
+            uint32_t count = 0;
+            for (uint32_t t = 0; t < threadCount; t++) {
+                sum += sums[t][c];
+                count += counts[t][c];
+            }
+            if (count > 0) {
+                centers[c] = glm::vec4(sum / double(count));
+            } else {
+                uint32_t worst = uint32_t(std::max_element(err.begin(), err.end()) - err.begin());
+                centers[c] = sample[worst];
+                err[worst] = 0.0f;
+            }
+        }
+    }
+
+    // ---------- 전체 할당 ----------
+    result.labels.resize(N);
+    std::vector<float> finalErr(N);
+    parallelFor(N, threadCount, [&](uint32_t i) {
+        result.labels[i] = uint8_t(detail::nearestCenter(points[i], centers, finalErr[i]));
+    });
+    double total = 0.0;
+    for (float e : finalErr) total += e;
+    result.mse = total / double(N);
+    return result;
+}
+
+}
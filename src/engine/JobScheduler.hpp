@@ -0,0 +1,433 @@
+// ============================================================
+// File: src/engine/JobScheduler.hpp
+// Role: 독립 학습/렌더 job 여러 개를 한 device에서 동시에 실행
+//       worker 스레드 병렬 기록 + compute queue 여러 개 + job별 fence
+// ============================================================
+//
+// job = step 반복 (학습 iteration, 렌더 batch 등). step 1개 흐름:
+//   1. ready 목록에서 worker가 job 선택 (정책 + aging)
+//   2. worker 전용 command pool의 command buffer에 record(cmd, step)
+//   3. queue 선택 → vkQueueSubmit(job fence)
+//   4. poller 스레드가 fence 완료 감지 → finish 작업 등록
+//   5. worker가 finish(step) (host 후처리: loss/grad 다운로드, SGD 등)
+//      → true면 다시 ready, false면 job 완료
+//
+// 한 job은 항상 step 1개만 in-flight → job 내부 상태는 동기화 불필요
+// 서로 다른 job은 기록/제출/후처리 모두 병렬
+//
+// 스레드 규칙 (Vulkan 외부 동기화):
+//   command pool : worker마다 1개, 그 worker만 할당/기록 (반납은 free 목록만)
+//   queue        : queue마다 mutex
+//   ComputeContext binding 표: job마다 별도 복사본 (TrainPipelines 값 복사 → 핸들 공유)
+//   scheduler 실행 중에는 engine.submitAndWait / engine.commandBuffer() 사용 금지
+//
+// 정책:
+//   RoundRobin: 오래 기다린 job부터 (FIFO), queue는 순서대로 돌아가며
+//   Priority  : priority + 대기시간 / agingMs 가 가장 큰 job, queue는 부하 최소
+//     → 큰 job은 step 1개씩만 점유하므로 작은 고우선 job이 사이사이 끼어듦
+//     → 낮은 priority job도 기다린 만큼 점수가 올라 결국 선택됨 (starvation 없음)
+// in-flight 상한 = queue 수 × maxInFlightPerQueue (GPU 대기열 과적재 방지)
+// ============================================================
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <string>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdio>
+#include <cstdint>
+
+#include "engine/VkEngine.hpp"
+#include "engine/VkCompute.hpp"
+
+namespace gs {
+
+enum class SchedulePolicy : uint32_t {
+    RoundRobin = 0,
+    Priority   = 1,
+};
+
+struct SchedulerConfig {
+    uint32_t       workers             = 0;     // 0 = hardware_concurrency
+    SchedulePolicy policy              = SchedulePolicy::Priority;
+    double         agingMs             = 50.0;  // 대기 agingMs마다 priority +1
+    uint32_t       maxInFlightPerQueue = 2;
+};
+
+// ------------------------------------------------------------
+// JobDesc: job 1개 (콜백은 worker 스레드에서 호출)
+// ------------------------------------------------------------
+// record: begin/end는 scheduler가 함, dispatch/barrier만 기록
+//         step 0 전에 필요한 업로드도 여기서 (이전 step은 이미 완료 상태)
+// finish: GPU 완료 후 host 처리, false = job 종료
+// ------------------------------------------------------------
+struct JobDesc {
+    std::string name;
+    int32_t     priority = 0;  // 클수록 먼저 (latency 민감 job)
+    std::function<void(VkCommandBuffer cmd, uint32_t step)> record;
+    std::function<bool(uint32_t step)> finish;
+};
+
+struct JobStats {
+    std::string name;
+    int32_t     priority = 0;
+    uint32_t    steps    = 0;
+    bool        failed   = false;
+    double      startMs  = 0.0;  // submitJob 시각
+    double      endMs    = 0.0;  // 마지막 finish 완료
+    std::vector<double> waitMs;  // ready → 제출 (기록 포함)
+    std::vector<double> gpuMs;   // 제출 → fence 완료 감지
+    std::vector<double> stepMs;  // ready → finish 완료
+    std::vector<uint32_t> queueSubmits;  // queue별 제출 수
+};
+
+class JobScheduler {
+public:
+    JobScheduler() = default;
+    JobScheduler(const JobScheduler&) = delete;
+    JobScheduler& operator=(const JobScheduler&) = delete;
+    ~JobScheduler() { shutdown(); }
+
+    // --------------------------------------------------------
+    // init: worker별 command pool + 스레드 시작
+    // --------------------------------------------------------
+    void init(const VkEngine& engine, const SchedulerConfig& cfg) {
+        device_ = engine.device();
+        queues_ = engine.computeQueues();
+        cfg_    = cfg;
+        const uint32_t workerCount = cfg.workers ? cfg.workers
+            : std::max(1u, std::thread::hardware_concurrency());
+
+        queueMutexes_ = std::vector<std::mutex>(queues_.size());
+        queueLoad_.assign(queues_.size(), 0);
+        workers_.resize(workerCount);
+        for (uint32_t w = 0; w < workerCount; w++) {
+            VkCommandPoolCreateInfo poolInfo{};
+            poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            poolInfo.queueFamilyIndex = engine.computeQueueFamily();
+            poolInfo.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+            workers_[w] = std::make_unique<Worker>();
+            if (vkCreateCommandPool(device_, &poolInfo, nullptr, &workers_[w]->pool) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create worker command pool");
+            }
+        }
+
+        stop_ = false;
+        for (uint32_t w = 0; w < workerCount; w++) {
+            workers_[w]->thread = std::thread([this, w]() { workerLoop(w); });
+        }
+        poller_ = std::thread([this]() { pollLoop(); });
+        printf("[Scheduler] %u workers, %zu compute queue(s), policy %s\n", workerCount, queues_.size(),
+            cfg.policy == SchedulePolicy::Priority ? "priority" : "round-robin");
+    }
+
+    // --------------------------------------------------------
+    // submitJob: 실행 중에도 추가 가능 (스레드 안전), 반환 = job id
+    // --------------------------------------------------------
+    uint32_t submitJob(JobDesc desc) {
+        auto job = std::make_unique<Job>();
+        job->desc = std::move(desc);
+        job->stats.name = job->desc.name;
+        job->stats.priority = job->desc.priority;
+        job->stats.queueSubmits.assign(queues_.size(), 0);
+
+        VkFenceCreateInfo fenceInfo{};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        if (vkCreateFence(device_, &fenceInfo, nullptr, &job->fence) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create job fence");
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        const uint32_t id = uint32_t(jobs_.size());
+        job->stats.startMs = nowMs();
+        job->readyMs = job->stats.startMs;
+        jobs_.push_back(std::move(job));
+        ready_.push_back(id);
+        pending_++;
+        cv_.notify_one();
+        return id;
+    }
+
+    // 지금까지 제출한 job이 모두 끝날 때까지 대기
+    void waitAll() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        doneCv_.wait(lock, [&]() { return pending_ == 0; });
+    }
+
+    std::vector<JobStats> stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<JobStats> out;
+        for (const auto& job : jobs_) out.push_back(job->stats);
+        return out;
+    }
+
+    // 대기 중인 job은 버림 (먼저 waitAll 권장)
+    void shutdown() {
+        if (device_ == VK_NULL_HANDLE) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        pollCv_.notify_all();
+        for (auto& w : workers_) if (w->thread.joinable()) w->thread.join();
+        if (poller_.joinable()) poller_.join();
+
+        for (VkQueue q : queues_) vkQueueWaitIdle(q);
+        for (auto& w : workers_) vkDestroyCommandPool(device_, w->pool, nullptr);
+        for (auto& job : jobs_) vkDestroyFence(device_, job->fence, nullptr);
+        workers_.clear();
+        jobs_.clear();
+        ready_.clear();
+        inFlight_.clear();
+        finished_.clear();
+        device_ = VK_NULL_HANDLE;
+    }
+
+private:
+    struct Job {
+        JobDesc  desc;
+        JobStats stats;
+        VkFence  fence   = VK_NULL_HANDLE;
+        uint32_t step    = 0;
+        double   readyMs = 0.0;
+    };
+
+    struct Worker {
+        VkCommandPool                pool = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer> freeCmds;  // 완료된 command buffer (mutex_ 보호)
+        std::thread                  thread;
+    };
+
+    // Job 객체는 unique_ptr로 주소 고정 → 잠금 안에서 얻은 포인터를 잠금 밖에서 사용
+    // (jobs_ deque는 submitJob의 push_back과 동시에 인덱싱하면 안 됨)
+    struct InFlight {
+        uint32_t        job;
+        Job*            owner;
+        uint32_t        worker;
+        uint32_t        queue;
+        VkCommandBuffer cmd;
+        double          submitMs;
+    };
+
+    VkDevice             device_ = VK_NULL_HANDLE;
+    std::vector<VkQueue> queues_;
+    SchedulerConfig      cfg_;
+
+    mutable std::mutex      mutex_;      // 아래 상태 전체 보호
+    std::condition_variable cv_;         // worker 깨우기
+    std::condition_variable pollCv_;     // poller 깨우기
+    std::condition_variable doneCv_;     // waitAll
+    bool                    stop_ = true;
+    uint32_t                pending_ = 0;          // 끝나지 않은 job 수
+    uint32_t                inFlightCount_ = 0;    // 기록 중 + 제출됨
+    uint32_t                rrNext_ = 0;
+    std::deque<std::unique_ptr<Job>> jobs_;
+    std::vector<uint32_t>   ready_;                // ready job id
+    std::vector<InFlight>   inFlight_;             // 제출 후 fence 대기
+    std::deque<InFlight>    finished_;             // fence 완료 → finish 대기
+    std::vector<uint32_t>   queueLoad_;            // queue별 in-flight 수
+
+    std::vector<std::mutex>              queueMutexes_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::thread                          poller_;
+
+    static double nowMs() {
+        using namespace std::chrono;
+        return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    bool hasCapacity() const {
+        return inFlightCount_ < uint32_t(queues_.size()) * std::max(1u, cfg_.maxInFlightPerQueue);
+    }
+
+    // ready_에서 다음 job 선택 (mutex_ 보유 상태)
+    size_t pickReady(double now) const {
+        size_t best = 0;
+        double bestScore = -1e300;
+        for (size_t i = 0; i < ready_.size(); i++) {
+            const Job& job = *jobs_[ready_[i]];
+            const double waited = now - job.readyMs;
+            double score = (cfg_.policy == SchedulePolicy::Priority)
+                ? double(job.desc.priority) + waited / std::max(cfg_.agingMs, 1e-3)
+                : waited;
+            if (score > bestScore) {
+                bestScore = score;
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    uint32_t pickQueue() {
+        if (cfg_.policy == SchedulePolicy::RoundRobin) {
+            return rrNext_++ % uint32_t(queues_.size());
+        }
+        return uint32_t(std::min_element(queueLoad_.begin(), queueLoad_.end()) - queueLoad_.begin());
+    }
+
+    // --------------------------------------------------------
+    // workerLoop: finish 작업 우선, 없으면 ready job 기록/제출
+    // --------------------------------------------------------
+    void workerLoop(uint32_t w) {
+        Worker& self = *workers_[w];
+        while (true) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [&]() {
+                return stop_ || !finished_.empty() || (!ready_.empty() && hasCapacity());
+            });
+            if (stop_) return;
+
+            if (!finished_.empty()) {
+                InFlight done = finished_.front();
+                finished_.pop_front();
+                lock.unlock();
+                runFinish(done);
+                continue;
+            }
+
+            // ---------- 기록 + 제출 ----------
+            const double now = nowMs();
+            const size_t pick = pickReady(now);
+            const uint32_t id = ready_[pick];
+            ready_.erase(ready_.begin() + pick);
+            const uint32_t q = pickQueue();
+            queueLoad_[q]++;
+            inFlightCount_++;
+            VkCommandBuffer cmd = VK_NULL_HANDLE;
+            if (!self.freeCmds.empty()) {
+                cmd = self.freeCmds.back();
+                self.freeCmds.pop_back();
+            }
+            Job& job = *jobs_[id];
+            lock.unlock();
+
+            bool ok = true;
+            try {
+                if (cmd == VK_NULL_HANDLE) {
+                    VkCommandBufferAllocateInfo allocInfo{};
+                    allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+                    allocInfo.commandPool        = self.pool;
+                    allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+                    allocInfo.commandBufferCount = 1;
+                    if (vkAllocateCommandBuffers(device_, &allocInfo, &cmd) != VK_SUCCESS) {
+                        cmd = VK_NULL_HANDLE;
+                        throw std::runtime_error("Failed to allocate command buffer");
+                    }
+                }
+                beginOneTimeCommands(cmd);
+                job.desc.record(cmd, job.step);
+                vkEndCommandBuffer(cmd);
+
+                vkResetFences(device_, 1, &job.fence);
+                VkSubmitInfo submitInfo{};
+                submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                submitInfo.commandBufferCount = 1;
+                submitInfo.pCommandBuffers    = &cmd;
+                std::lock_guard<std::mutex> queueLock(queueMutexes_[q]);
+                if (vkQueueSubmit(queues_[q], 1, &submitInfo, job.fence) != VK_SUCCESS) {
+                    throw std::runtime_error("Failed to submit job " + job.desc.name);
+                }
+            } catch (const std::exception& e) {
+                printf("[Error] Job %s: %s\n", job.desc.name.c_str(), e.what());
+                ok = false;
+                // record 도중 예외 → 아직 recording 상태일 수 있음, initial로 되돌려야 다시 begin 가능
+                // (pool은 이 worker 전용 → lock 없이 reset)
+                if (cmd != VK_NULL_HANDLE) vkResetCommandBuffer(cmd, 0);
+            }
+
+            lock.lock();
+            if (!ok) {
+                queueLoad_[q]--;
+                inFlightCount_--;
+                if (cmd != VK_NULL_HANDLE) self.freeCmds.push_back(cmd);
+                completeJob(job, true);
+                continue;
+            }
+            job.stats.waitMs.push_back(nowMs() - job.readyMs);
+            job.stats.queueSubmits[q]++;
+            inFlight_.push_back({ id, &job, w, q, cmd, nowMs() });
+            pollCv_.notify_one();
+        }
+    }
+
+    // GPU 완료된 step의 host 처리 (mutex_ 미보유 상태에서 호출)
+    void runFinish(const InFlight& done) {
+        Job& job = *done.owner;
+        bool more = false;
+        bool failed = false;
+        try {
+            more = job.desc.finish(job.step);
+        } catch (const std::exception& e) {
+            printf("[Error] Job %s: %s\n", job.desc.name.c_str(), e.what());
+            failed = true;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        workers_[done.worker]->freeCmds.push_back(done.cmd);  // 재기록은 소유 worker만
+        const double now = nowMs();
+        job.stats.stepMs.push_back(now - job.readyMs);
+        job.stats.steps++;
+        job.step++;
+        if (more && !failed) {
+            job.readyMs = now;
+            ready_.push_back(done.job);
+            cv_.notify_one();
+        } else {
+            completeJob(job, failed);
+        }
+    }
+
+    // mutex_ 보유 상태에서 호출
+    void completeJob(Job& job, bool failed) {
+        job.stats.failed = failed;
+        job.stats.endMs = nowMs();
+        pending_--;
+        doneCv_.notify_all();
+    }
+
+    // --------------------------------------------------------
+    // pollLoop: in-flight fence 중 완료된 것을 finished_로
+    // --------------------------------------------------------
+    // fence는 그 step의 finish가 끝나야 다시 reset되므로 잠금 밖에서 대기해도 안전
+    // --------------------------------------------------------
+    void pollLoop() {
+        std::vector<VkFence> fences;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                pollCv_.wait(lock, [&]() { return stop_ || !inFlight_.empty(); });
+                if (stop_) return;
+                fences.clear();
+                for (const InFlight& f : inFlight_) fences.push_back(f.owner->fence);
+            }
+            vkWaitForFences(device_, uint32_t(fences.size()), fences.data(), VK_FALSE, 1000000);  // 1 ms
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            const double now = nowMs();
+            for (size_t i = 0; i < inFlight_.size();) {
+                Job& job = *inFlight_[i].owner;
+                if (vkGetFenceStatus(device_, job.fence) == VK_SUCCESS) {
+                    job.stats.gpuMs.push_back(now - inFlight_[i].submitMs);
+                    queueLoad_[inFlight_[i].queue]--;
+                    inFlightCount_--;
+                    finished_.push_back(inFlight_[i]);
+                    inFlight_.erase(inFlight_.begin() + i);
+                    cv_.notify_all();
+                } else {
+                    i++;
+                }
+            }
+        }
+    }
+};
+
+} // namespace gs
@@ -8,6 +8,11 @@
 #include <stdexcept>
 #include <cstdio>
 #include <cstring>  // memcpy
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
 
 namespace gs {
 
@@ -49,13 +54,62 @@ inline uint32_t findMemoryType(
 //   2. VkDeviceMemory 할당 후 바인딩
 //
 // 항상 짝으로 다니므로 묶어서 관리
+//
+// id: 프로세스 안에서 재사용되지 않는 번호 (descriptor set cache 키)
+//   → 버퍼를 지우고 새로 만들 때 VkBuffer 핸들 값이 같아져도 구분됨
 // ------------------------------------------------------------
 struct BufferBundle {
     VkBuffer       buffer = VK_NULL_HANDLE;
     VkDeviceMemory memory = VK_NULL_HANDLE;
     VkDeviceSize   size   = 0;
+    uint64_t       id     = 0;
 };
 
+inline uint64_t nextBufferId() {
+    static std::atomic<uint64_t> counter{ 0 };
+    return ++counter;
+}
+
+// ------------------------------------------------------------
+// 버퍼 해제 알림: destroyBuffer가 id를 등록된 listener에 전달
+// ------------------------------------------------------------
+// id가 재사용되지 않으므로 id를 키로 쓰는 cache는 직접 지워야 함
+//   (VkCompute.hpp DescriptorSystem fallback cache가 등록)
+// ------------------------------------------------------------
+struct BufferReleaseListener {
+    void (*fn)(void* user, uint64_t id);
+    void* user;
+};
+
+struct BufferReleaseRegistry {
+    std::vector<BufferReleaseListener> listeners;
+    std::mutex                         mutex;
+};
+
+inline BufferReleaseRegistry& bufferReleaseRegistry() {
+    static BufferReleaseRegistry registry;
+    return registry;
+}
+
+inline void addBufferReleaseListener(void (*fn)(void*, uint64_t), void* user) {
+    BufferReleaseRegistry& r = bufferReleaseRegistry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.listeners.push_back({ fn, user });
+}
+
+inline void removeBufferReleaseListener(void* user) {
+    BufferReleaseRegistry& r = bufferReleaseRegistry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.listeners.erase(std::remove_if(r.listeners.begin(), r.listeners.end(),
+        [user](const BufferReleaseListener& l) { return l.user == user; }), r.listeners.end());
+}
+
+inline void notifyBufferRelease(uint64_t id) {
+    BufferReleaseRegistry& r = bufferReleaseRegistry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const BufferReleaseListener& l : r.listeners) l.fn(l.user, id);
+}
+
 // ------------------------------------------------------------
 // createBuffer: 범용 버퍼 생성
 // ------------------------------------------------------------
@@ -64,16 +118,22 @@ struct BufferBundle {
 //   VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT  → UBO (상수 데이터)
 //   VK_BUFFER_USAGE_TRANSFER_SRC_BIT    → staging (CPU→GPU 복사 출발지)
 //   VK_BUFFER_USAGE_TRANSFER_DST_BIT    → GPU 버퍼 (복사 목적지)
+//
+// queueFamilies: 서로 다른 family 2개 이상이면 CONCURRENT 공유
+//   (예: transfer queue가 쓰고 compute queue가 읽는 스트리밍 pool)
+//   → ownership transfer barrier 없이 두 queue에서 사용
 // ------------------------------------------------------------
 inline BufferBundle createBuffer(
     VkDevice device,
     VkPhysicalDevice physicalDevice,
     VkDeviceSize size,
     VkBufferUsageFlags usage,
-    VkMemoryPropertyFlags memProps
+    VkMemoryPropertyFlags memProps,
+    std::vector<uint32_t> queueFamilies = {}
 ) {
     BufferBundle bundle;
     bundle.size = size;
+    bundle.id   = nextBufferId();
 
     // Step 1: Create buffer (metadata only)
     VkBufferCreateInfo bufferInfo{};
@@ -82,6 +142,14 @@ inline BufferBundle createBuffer(
     bufferInfo.usage       = usage;
     bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;  // 한 큐에서만 사용
 
+    std::sort(queueFamilies.begin(), queueFamilies.end());
+    queueFamilies.erase(std::unique(queueFamilies.begin(), queueFamilies.end()), queueFamilies.end());
+    if (queueFamilies.size() > 1) {
+        bufferInfo.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+        bufferInfo.queueFamilyIndexCount = uint32_t(queueFamilies.size());
+        bufferInfo.pQueueFamilyIndices   = queueFamilies.data();
+    }
+
     if (vkCreateBuffer(device, &bufferInfo, nullptr, &bundle.buffer) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create buffer");
     }
@@ -109,7 +177,10 @@ inline BufferBundle createBuffer(
 // ------------------------------------------------------------
 // destroyBuffer: 버퍼 정리
 // ------------------------------------------------------------
+// 이 버퍼를 참조하던 cache된 descriptor set도 함께 반환 (notifyBufferRelease)
+// ------------------------------------------------------------
 inline void destroyBuffer(VkDevice device, BufferBundle& bundle) {
+    if (bundle.id != 0) notifyBufferRelease(bundle.id);
     if (bundle.buffer != VK_NULL_HANDLE) {
         vkDestroyBuffer(device, bundle.buffer, nullptr);
         bundle.buffer = VK_NULL_HANDLE;
@@ -118,6 +189,7 @@ inline void destroyBuffer(VkDevice device, BufferBundle& bundle) {
         vkFreeMemory(device, bundle.memory, nullptr);
         bundle.memory = VK_NULL_HANDLE;
     }
+    bundle.id = 0;
 }
 
 // ------------------------------------------------------------
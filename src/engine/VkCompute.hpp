@@ -1,13 +1,21 @@
 // ============================================================
-// File: src/engine/VkCompute.hpp (v2 - 다중 바인딩 + push constants)
+// File: src/engine/VkCompute.hpp (v3 - 다중 바인딩 + push constants + 공용 descriptor)
 // ============================================================
 #pragma once
 
 #include <vulkan/vulkan.h>
 #include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <string>
 #include <fstream>
 #include <stdexcept>
 #include <cstdio>
+#include <cstdint>
+
+#include "engine/VkBuffer.hpp"
 
 namespace gs {
 
@@ -28,35 +36,141 @@ inline std::vector<char> loadSPV(const std::string& filename) {
 }
 
 // ------------------------------------------------------------
-// ComputeContext (동일)
+// DescriptorSystem: 모든 pipeline이 공유하는 descriptor 관리
+// ------------------------------------------------------------
+// bindSSBO는 host 쪽 binding 표만 바꾸고, 실제 연결은 dispatch 기록 시점에:
+//
+//   1. Push descriptor (VK_KHR_push_descriptor 지원 시)
+//      → vkCmdPushDescriptorSetKHR로 command buffer에 직접 기록
+//      → descriptor set / pool / vkUpdateDescriptorSets 없음
+//   2. 공유 pool (fallback)
+//      → (layout, 버퍼 id 조합)마다 set 1개를 만들어 cache
+//      → 같은 조합은 재사용, 처음 보는 조합만 vkUpdateDescriptorSets 1회
+//      → 한 번 쓴 set은 다시 쓰지 않으므로 기록/제출 중인 command buffer와 충돌 없음
+//      → destroyBuffer / destroyComputePipeline 시 관련 set을 pool에 반환
+//        (버퍼를 config마다 새로 만드는 bench 등에서 set/pool이 계속 늘지 않도록)
+//
+// 어느 쪽이든 binding은 기록 시점 값으로 고정
+//   → 같은 command buffer 안에서 dispatch마다 버퍼를 바꿔도 됨 (ping-pong, level별 target 등)
+//
+// 여러 스레드 동시 기록 (JobScheduler): fallback cache는 mutex, 통계는 atomic
+//   ComputeContext의 binding 표는 스레드마다 별도 복사본이어야 함
+// ------------------------------------------------------------
+const uint32_t DESCRIPTOR_POOL_SETS    = 256;   // fallback pool 1개당 set 수
+const uint32_t DESCRIPTOR_POOL_BUFFERS = 2048;  // fallback pool 1개당 SSBO descriptor 수
+const uint32_t MAX_PUSH_BINDINGS       = 32;    // push descriptor 1회 기록 상한 (스택 배열)
+
+struct DescriptorStats {
+    std::atomic<uint64_t> pushes{0};     // push descriptor 기록 횟수
+    std::atomic<uint64_t> cacheHits{0};  // fallback: cache된 set 재사용
+    std::atomic<uint64_t> setWrites{0};  // fallback: 새 set 할당 + vkUpdateDescriptorSets
+};
+
+struct CachedDescriptorSet {
+    VkDescriptorSet  set;
+    VkDescriptorPool pool;
+};
+
+struct DescriptorSystem {
+    VkDevice                      device              = VK_NULL_HANDLE;
+    bool                          pushDescriptors     = false;
+    uint32_t                      maxPushDescriptors  = 0;
+    PFN_vkCmdPushDescriptorSetKHR cmdPushDescriptorSet = nullptr;
+
+    // fallback 공유 pool (가득 차면 하나 더)
+    std::vector<VkDescriptorPool> pools;
+    std::map<std::vector<uint64_t>, CachedDescriptorSet> cache;
+    std::mutex                    cacheMutex;  // pools/cache 보호 (다중 스레드 기록)
+
+    DescriptorStats stats;
+};
+
+// 버퍼 해제 listener: 키(layout 뒤 버퍼 id들)에 id가 있는 set 전부 반환
+inline void releaseBufferDescriptors(void* user, uint64_t id) {
+    DescriptorSystem& ds = *static_cast<DescriptorSystem*>(user);
+    std::lock_guard<std::mutex> lock(ds.cacheMutex);
+    for (auto it = ds.cache.begin(); it != ds.cache.end();) {
+        if (std::find(it->first.begin() + 1, it->first.end(), id) != it->first.end()) {
+            vkFreeDescriptorSets(ds.device, it->second.pool, 1, &it->second.set);
+            it = ds.cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// pushFn = nullptr이면 fallback pool만 사용
+inline void initDescriptorSystem(
+    DescriptorSystem& ds,
+    VkDevice device,
+    PFN_vkCmdPushDescriptorSetKHR pushFn,
+    uint32_t maxPushDescriptors
+) {
+    ds.device               = device;
+    ds.cmdPushDescriptorSet = pushFn;
+    ds.maxPushDescriptors   = maxPushDescriptors;
+    ds.pushDescriptors      = (pushFn != nullptr && maxPushDescriptors > 0);
+    addBufferReleaseListener(releaseBufferDescriptors, &ds);
+    printf("  [+] Descriptors: %s\n", ds.pushDescriptors ? "push descriptors" : "shared pool");
+}
+
+inline void destroyDescriptorSystem(DescriptorSystem& ds) {
+    removeBufferReleaseListener(&ds);
+    for (VkDescriptorPool pool : ds.pools) vkDestroyDescriptorPool(ds.device, pool, nullptr);
+    ds.pools.clear();
+    ds.cache.clear();
+}
+
+// Vulkan 핸들 → cache 키 (64-bit: 포인터, 32-bit: uint64 모두 허용)
+template <typename Handle>
+inline uint64_t handleKey(Handle h) {
+    return (uint64_t)h;
+}
+
+// ------------------------------------------------------------
+// ComputeContext
+// ------------------------------------------------------------
+// bindings / bindingIds: 현재 binding 표 (bindSSBO로 설정, 기록 시 사용)
+// pushDescriptors: 이 layout이 push descriptor로 만들어졌는지
 // ------------------------------------------------------------
 struct ComputeContext {
     VkShaderModule        shaderModule        = VK_NULL_HANDLE;
     VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
     VkPipelineLayout      pipelineLayout      = VK_NULL_HANDLE;
     VkPipeline            pipeline            = VK_NULL_HANDLE;
-    VkDescriptorPool      descriptorPool      = VK_NULL_HANDLE;
-    VkDescriptorSet       descriptorSet       = VK_NULL_HANDLE;
+    DescriptorSystem*     descriptors         = nullptr;
+    bool                  pushDescriptors     = false;
+    std::vector<VkDescriptorBufferInfo> bindings;
+    std::vector<uint64_t>               bindingIds;
 };
 
 // ------------------------------------------------------------
-// createComputePipeline (확장: 바인딩 개수 + push constant 크기)
+// createComputePipeline (바인딩 개수 + push constant 크기)
 // ------------------------------------------------------------
 // bindingCount: SSBO 개수 (binding 0, 1, 2, ...)
 // pushConstantSize: push constant 구조체 크기 (0이면 안 씀)
+// specConstants: constant_id i = specConstants[i] (32-bit, bool은 0/1)
 //
 // 예시:
 //   simple.comp: bindingCount=1, pushConstantSize=0
 //   gaussian.comp: bindingCount=2, pushConstantSize=12 (3 * uint)
+//   계측 빌드: specConstants = { 1 } (INSTRUMENT = true)
 // ------------------------------------------------------------
 inline ComputeContext createComputePipeline(
-    VkDevice device,
+    DescriptorSystem& ds,
     const std::string& shaderPath,
     uint32_t bindingCount = 1,
-    uint32_t pushConstantSize = 0
+    uint32_t pushConstantSize = 0,
+    const std::vector<uint32_t>& specConstants = {}
 ) {
+    VkDevice device = ds.device;
     ComputeContext ctx;
-    
+    ctx.descriptors     = &ds;
+    ctx.pushDescriptors = ds.pushDescriptors &&
+        bindingCount <= std::min(ds.maxPushDescriptors, MAX_PUSH_BINDINGS);
+    ctx.bindings.assign(bindingCount, VkDescriptorBufferInfo{ VK_NULL_HANDLE, 0, 0 });
+    ctx.bindingIds.assign(bindingCount, 0);
+
     // ===== Shader Module =====
     auto code = loadSPV(shaderPath);
     VkShaderModuleCreateInfo moduleInfo{};
@@ -67,7 +181,7 @@ inline ComputeContext createComputePipeline(
     if (vkCreateShaderModule(device, &moduleInfo, nullptr, &ctx.shaderModule) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create shader module");
     }
-    printf("  [1/5] Shader module loaded\n");
+    printf("  [1/4] Shader module loaded\n");
     
     // ===== Descriptor Set Layout (다중 바인딩) =====
     std::vector<VkDescriptorSetLayoutBinding> bindings(bindingCount);
@@ -82,11 +196,15 @@ inline ComputeContext createComputePipeline(
     layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
     layoutInfo.bindingCount = bindingCount;
     layoutInfo.pBindings    = bindings.data();
+    if (ctx.pushDescriptors) {
+        layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+    }
     
     if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &ctx.descriptorSetLayout) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create descriptor set layout");
     }
-    printf("  [2/5] Descriptor set layout (%u bindings)\n", bindingCount);
+    printf("  [2/4] Descriptor set layout (%u bindings, %s)\n",
+        bindingCount, ctx.pushDescriptors ? "push" : "pooled");
     
     // ===== Pipeline Layout (push constants 포함) =====
     VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
@@ -106,8 +224,21 @@ inline ComputeContext createComputePipeline(
     if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &ctx.pipelineLayout) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create pipeline layout");
     }
-    printf("  [3/5] Pipeline layout (push=%u bytes)\n", pushConstantSize);
+    printf("  [3/4] Pipeline layout (push=%u bytes)\n", pushConstantSize);
     
+    // ===== Specialization constants =====
+    std::vector<VkSpecializationMapEntry> specEntries(specConstants.size());
+    for (uint32_t i = 0; i < specConstants.size(); i++) {
+        specEntries[i].constantID = i;
+        specEntries[i].offset     = i * uint32_t(sizeof(uint32_t));
+        specEntries[i].size       = sizeof(uint32_t);
+    }
+    VkSpecializationInfo specInfo{};
+    specInfo.mapEntryCount = uint32_t(specEntries.size());
+    specInfo.pMapEntries   = specEntries.data();
+    specInfo.dataSize      = specConstants.size() * sizeof(uint32_t);
+    specInfo.pData         = specConstants.data();
+
     // ===== Compute Pipeline =====
     VkComputePipelineCreateInfo pipelineInfo{};
     pipelineInfo.sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
@@ -116,67 +247,239 @@ inline ComputeContext createComputePipeline(
     pipelineInfo.stage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
     pipelineInfo.stage.module = ctx.shaderModule;
     pipelineInfo.stage.pName  = "main";
+    pipelineInfo.stage.pSpecializationInfo = specConstants.empty() ? nullptr : &specInfo;
     
     if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &ctx.pipeline) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create compute pipeline");
     }
-    printf("  [4/5] Compute pipeline created\n");
+    printf("  [4/4] Compute pipeline created\n");
     
-    // ===== Descriptor Pool =====
+    return ctx;
+}
+
+// ------------------------------------------------------------
+// bindSSBO: binding 표만 갱신 (Vulkan 호출 없음)
+// ------------------------------------------------------------
+// 다음에 기록하는 dispatch부터 적용, 이미 기록한 dispatch는 그대로
+// ------------------------------------------------------------
+inline void bindSSBO(ComputeContext& ctx, const BufferBundle& buffer, uint32_t binding = 0) {
+    if (binding >= ctx.bindings.size()) {
+        throw std::runtime_error("bindSSBO: binding out of range");
+    }
+    ctx.bindings[binding]   = VkDescriptorBufferInfo{ buffer.buffer, 0, buffer.size };
+    ctx.bindingIds[binding] = buffer.id;
+}
+
+// ------------------------------------------------------------
+// acquireDescriptorSet (fallback): 현재 binding 조합의 set 찾기/만들기
+// ------------------------------------------------------------
+inline VkDescriptorPool createSharedDescriptorPool(VkDevice device) {
     VkDescriptorPoolSize poolSize{};
     poolSize.type            = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    poolSize.descriptorCount = bindingCount * 2;  // 여유분
-    
+    poolSize.descriptorCount = DESCRIPTOR_POOL_BUFFERS;
+
     VkDescriptorPoolCreateInfo poolInfo{};
     poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags         = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;  // pipeline 삭제 시 반환
     poolInfo.poolSizeCount = 1;
     poolInfo.pPoolSizes    = &poolSize;
-    poolInfo.maxSets       = 4;
-    
-    if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &ctx.descriptorPool) != VK_SUCCESS) {
+    poolInfo.maxSets       = DESCRIPTOR_POOL_SETS;
+
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create descriptor pool");
     }
-    printf("  [5/5] Descriptor pool created\n");
-    
-    // ===== Allocate Descriptor Set =====
+    return pool;
+}
+
+inline VkDescriptorSet acquireDescriptorSet(const ComputeContext& ctx) {
+    DescriptorSystem& ds = *ctx.descriptors;
+
+    std::vector<uint64_t> key;
+    key.reserve(ctx.bindingIds.size() + 1);
+    key.push_back(handleKey(ctx.descriptorSetLayout));
+    key.insert(key.end(), ctx.bindingIds.begin(), ctx.bindingIds.end());
+
+    std::lock_guard<std::mutex> lock(ds.cacheMutex);
+    auto it = ds.cache.find(key);
+    if (it != ds.cache.end()) {
+        ds.stats.cacheHits++;
+        return it->second.set;
+    }
+
+    // ===== 새 set 할당 (반환된 자리가 있는 pool 먼저, 모두 가득 차면 pool 추가) =====
     VkDescriptorSetAllocateInfo allocInfo{};
     allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    allocInfo.descriptorPool     = ctx.descriptorPool;
     allocInfo.descriptorSetCount = 1;
     allocInfo.pSetLayouts        = &ctx.descriptorSetLayout;
-    
-    if (vkAllocateDescriptorSets(device, &allocInfo, &ctx.descriptorSet) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to allocate descriptor set");
+
+    VkDescriptorSet set = VK_NULL_HANDLE;
+    VkResult result = VK_ERROR_OUT_OF_POOL_MEMORY;
+    for (size_t i = ds.pools.size(); i-- > 0 && result != VK_SUCCESS;) {
+        allocInfo.descriptorPool = ds.pools[i];
+        result = vkAllocateDescriptorSets(ds.device, &allocInfo, &set);
     }
-    printf("  [+] Descriptor set allocated\n");
-    
-    return ctx;
+    if (result != VK_SUCCESS) {
+        ds.pools.push_back(createSharedDescriptorPool(ds.device));
+        allocInfo.descriptorPool = ds.pools.back();
+        if (vkAllocateDescriptorSets(ds.device, &allocInfo, &set) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate descriptor set");
+        }
+    }
+
+    // ===== 바인딩된 slot만 기록 =====
+    std::vector<VkWriteDescriptorSet> writes;
+    writes.reserve(ctx.bindings.size());
+    for (uint32_t i = 0; i < ctx.bindings.size(); i++) {
+        if (ctx.bindings[i].buffer == VK_NULL_HANDLE) continue;
+        VkWriteDescriptorSet write{};
+        write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet          = set;
+        write.dstBinding      = i;
+        write.descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        write.descriptorCount = 1;
+        write.pBufferInfo     = &ctx.bindings[i];
+        writes.push_back(write);
+    }
+    vkUpdateDescriptorSets(ds.device, uint32_t(writes.size()), writes.data(), 0, nullptr);
+
+    ds.cache.emplace(std::move(key), CachedDescriptorSet{ set, allocInfo.descriptorPool });
+    ds.stats.setWrites++;
+    return set;
 }
 
-// bindSSBO, destroyComputePipeline (동일)
-inline void bindSSBO(VkDevice device, ComputeContext& ctx, VkBuffer buffer, VkDeviceSize size, uint32_t binding = 0) {
-    VkDescriptorBufferInfo bufferInfo{};
-    bufferInfo.buffer = buffer;
-    bufferInfo.offset = 0;
-    bufferInfo.range  = size;
-    
-    VkWriteDescriptorSet write{};
-    write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    write.dstSet          = ctx.descriptorSet;
-    write.dstBinding      = binding;
-    write.dstArrayElement = 0;
-    write.descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    write.descriptorCount = 1;
-    write.pBufferInfo     = &bufferInfo;
+// ------------------------------------------------------------
+// recordDescriptors: 현재 binding 표를 command buffer에 연결
+// ------------------------------------------------------------
+inline void recordDescriptors(VkCommandBuffer cmd, const ComputeContext& ctx) {
+    DescriptorSystem& ds = *ctx.descriptors;
+    if (!ctx.pushDescriptors) {
+        VkDescriptorSet set = acquireDescriptorSet(ctx);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE,
+            ctx.pipelineLayout, 0, 1, &set, 0, nullptr);
+        return;
+    }
+
+    VkWriteDescriptorSet writes[MAX_PUSH_BINDINGS];
+    uint32_t writeCount = 0;
+    for (uint32_t i = 0; i < ctx.bindings.size(); i++) {
+        if (ctx.bindings[i].buffer == VK_NULL_HANDLE) continue;
+        VkWriteDescriptorSet& write = writes[writeCount++];
+        write = VkWriteDescriptorSet{};
+        write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstBinding      = i;
+        write.descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        write.descriptorCount = 1;
+        write.pBufferInfo     = &ctx.bindings[i];
+    }
+    ds.cmdPushDescriptorSet(cmd, VK_PIPELINE_BIND_POINT_COMPUTE,
+        ctx.pipelineLayout, 0, writeCount, writes);
+    ds.stats.pushes++;
+}
 
-    // connect to shader 
-    vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+// ------------------------------------------------------------
+// beginOneTimeCommands: 1회 제출용 command buffer 기록 시작
+// ------------------------------------------------------------
+inline void beginOneTimeCommands(VkCommandBuffer cmd) {
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(cmd, &beginInfo);
 }
 
+// ------------------------------------------------------------
+// recordDispatch: bind pipeline + descriptors + push constants + dispatch
+// ------------------------------------------------------------
+// 매 pass마다 반복되는 4단계를 한 번에 기록
+// pushSize = 0이면 push constant 생략
+// ------------------------------------------------------------
+inline void recordDispatch(
+    VkCommandBuffer cmd,
+    const ComputeContext& ctx,
+    const void* pushData,
+    uint32_t pushSize,
+    uint32_t groupsX,
+    uint32_t groupsY = 1,
+    uint32_t groupsZ = 1
+) {
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, ctx.pipeline);
+    recordDescriptors(cmd, ctx);
+    if (pushSize > 0) {
+        vkCmdPushConstants(cmd, ctx.pipelineLayout,
+            VK_SHADER_STAGE_COMPUTE_BIT, 0, pushSize, pushData);
+    }
+    vkCmdDispatch(cmd, groupsX, groupsY, groupsZ);
+}
+
+// ------------------------------------------------------------
+// recordComputeBarrier: compute write → compute read
+// ------------------------------------------------------------
+inline void recordComputeBarrier(VkCommandBuffer cmd) {
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+// ------------------------------------------------------------
+// recordDispatchIndirect: recordDispatch와 동일, workgroup 수는 GPU 버퍼에서
+// ------------------------------------------------------------
+// buffer + offset 위치에 VkDispatchIndirectCommand {x, y, z}
+// buffer는 VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT로 생성되어 있어야 함
+// ------------------------------------------------------------
+inline void recordDispatchIndirect(
+    VkCommandBuffer cmd,
+    const ComputeContext& ctx,
+    const void* pushData,
+    uint32_t pushSize,
+    VkBuffer argsBuffer,
+    VkDeviceSize argsOffset
+) {
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, ctx.pipeline);
+    recordDescriptors(cmd, ctx);
+    if (pushSize > 0) {
+        vkCmdPushConstants(cmd, ctx.pipelineLayout,
+            VK_SHADER_STAGE_COMPUTE_BIT, 0, pushSize, pushData);
+    }
+    vkCmdDispatchIndirect(cmd, argsBuffer, argsOffset);
+}
+
+// ------------------------------------------------------------
+// recordIndirectBarrier: compute write → indirect 인자 읽기 + compute read
+// ------------------------------------------------------------
+inline void recordIndirectBarrier(VkCommandBuffer cmd) {
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+// ------------------------------------------------------------
+// destroyComputePipeline: 이 layout으로 cache된 set도 pool에 반환
+// ------------------------------------------------------------
+// (layout 핸들 값이 재사용되어도 옛 set이 잡히지 않도록)
+// ------------------------------------------------------------
 inline void destroyComputePipeline(VkDevice device, ComputeContext& ctx) {
+    if (ctx.descriptors != nullptr) {
+        DescriptorSystem& ds = *ctx.descriptors;
+        std::lock_guard<std::mutex> lock(ds.cacheMutex);
+        const uint64_t layoutKey = handleKey(ctx.descriptorSetLayout);
+        for (auto it = ds.cache.begin(); it != ds.cache.end();) {
+            if (it->first[0] == layoutKey) {
+                vkFreeDescriptorSets(device, it->second.pool, 1, &it->second.set);
+                it = ds.cache.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
     vkDestroyPipeline(device, ctx.pipeline, nullptr);
     vkDestroyPipelineLayout(device, ctx.pipelineLayout, nullptr);
-    vkDestroyDescriptorPool(device, ctx.descriptorPool, nullptr);
     vkDestroyDescriptorSetLayout(device, ctx.descriptorSetLayout, nullptr);
     vkDestroyShaderModule(device, ctx.shaderModule, nullptr);
 }
@@ -8,8 +8,13 @@
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
 #include <vector>
+#include <algorithm>
 #include <stdexcept>
 #include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "engine/VkCompute.hpp"
 
 namespace gs {
 
@@ -18,10 +23,15 @@ public:
     // --------------------------------------------------------
     // Lifecycle
     // --------------------------------------------------------
-    void init(GLFWwindow* window) {
+    // deviceFilter: GPU 이름 부분 문자열 (예: "llvmpipe" = lavapipe)
+    //              nullptr이면 discrete GPU 우선
+    // pushDescriptors: false면 지원해도 공유 descriptor pool 사용 (fallback 검증/비교용)
+    // computeQueueCount: 요청할 compute queue 수 (JobScheduler용, family 한도까지)
+    void init(GLFWwindow* window, const char* deviceFilter = nullptr, bool pushDescriptors = true,
+              uint32_t computeQueueCount = 1) {
         createInstance();
-        pickPhysicalDevice();
-        createLogicalDevice();
+        pickPhysicalDevice(deviceFilter);
+        createLogicalDevice(pushDescriptors, computeQueueCount);
         createCommandPool();
         allocateCommandBuffer();
         printf("[VkEngine] Initialized successfully\n");
@@ -29,6 +39,7 @@ public:
 
     void cleanup() {
         // Reverse order of creation
+        destroyDescriptorSystem(descriptors_);
         vkDestroyCommandPool(device_, commandPool_, nullptr);
         vkDestroyDevice(device_, nullptr);
         vkDestroyInstance(instance_, nullptr);
@@ -43,6 +54,53 @@ public:
     VkCommandPool  commandPool()   const { return commandPool_; }
     VkCommandBuffer commandBuffer() const { return commandBuffer_; }
     VkPhysicalDevice physicalDevice() const { return physicalDevice_; }
+    uint32_t       computeQueueFamily() const { return computeQueueFamily_; }
+    // computeQueues()[0] == computeQueue() (submitAndWait가 쓰는 queue)
+    const std::vector<VkQueue>& computeQueues() const { return computeQueues_; }
+    VkQueue        transferQueue() const { return transferQueue_; }
+    uint32_t       transferQueueFamily() const { return transferQueueFamily_; }
+    const std::string& deviceName() const { return deviceName_; }
+
+    // pipeline 생성/기록 모두 이 descriptor 시스템을 공유
+    // (cache 갱신은 engine 상태가 아니므로 const engine에서도 사용)
+    DescriptorSystem& descriptors() const { return descriptors_; }
+
+    // --------------------------------------------------------
+    // submitAndWait: 1회성 command buffer 제출 후 완료 대기
+    // --------------------------------------------------------
+    // 학습 루프처럼 매번 결과를 CPU로 읽어야 할 때 사용
+    // --------------------------------------------------------
+    void submitAndWait(VkCommandBuffer cmd) const {
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers    = &cmd;
+        if (vkQueueSubmit(computeQueue_, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to submit command buffer");
+        }
+        vkQueueWaitIdle(computeQueue_);
+    }
+
+    // --------------------------------------------------------
+    // submitAndWait + semaphore 대기 (예: transfer queue 업로드 완료)
+    // --------------------------------------------------------
+    // compute shader 단계만 semaphore를 기다림 → host는 막히지 않고 GPU끼리 순서 보장
+    // --------------------------------------------------------
+    void submitAndWait(VkCommandBuffer cmd, const std::vector<VkSemaphore>& waitSemaphores) const {
+        std::vector<VkPipelineStageFlags> waitStages(waitSemaphores.size(),
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.waitSemaphoreCount = uint32_t(waitSemaphores.size());
+        submitInfo.pWaitSemaphores    = waitSemaphores.data();
+        submitInfo.pWaitDstStageMask  = waitStages.data();
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers    = &cmd;
+        if (vkQueueSubmit(computeQueue_, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to submit command buffer");
+        }
+        vkQueueWaitIdle(computeQueue_);
+    }
 
 private:
     // --------------------------------------------------------
@@ -52,9 +110,14 @@ private:
     VkPhysicalDevice physicalDevice_ = VK_NULL_HANDLE;
     VkDevice         device_         = VK_NULL_HANDLE;
     VkQueue          computeQueue_   = VK_NULL_HANDLE;
+    std::vector<VkQueue> computeQueues_;
     VkCommandPool    commandPool_    = VK_NULL_HANDLE;
     VkCommandBuffer  commandBuffer_  = VK_NULL_HANDLE;
     uint32_t         computeQueueFamily_ = 0;
+    VkQueue          transferQueue_  = VK_NULL_HANDLE;
+    uint32_t         transferQueueFamily_ = 0;
+    std::string      deviceName_;
+    mutable DescriptorSystem descriptors_;
 
     // --------------------------------------------------------
     // Step 1: Create Vulkan Instance
@@ -90,8 +153,9 @@ private:
     // --------------------------------------------------------
     // Physical Device = actual GPU hardware
     // We pick the first discrete GPU, or fallback to any GPU
+    // deviceFilter가 있으면 이름에 포함된 GPU만 선택 (없으면 에러)
     // --------------------------------------------------------
-    void pickPhysicalDevice() {
+    void pickPhysicalDevice(const char* deviceFilter) {
         uint32_t deviceCount = 0;
         vkEnumeratePhysicalDevices(instance_, &deviceCount, nullptr);
         if (deviceCount == 0) {
@@ -101,12 +165,28 @@ private:
         std::vector<VkPhysicalDevice> devices(deviceCount);
         vkEnumeratePhysicalDevices(instance_, &deviceCount, devices.data());
 
+        // Explicit filter (e.g. "llvmpipe" for CPU Vulkan)
+        if (deviceFilter != nullptr && deviceFilter[0] != '\0') {
+            for (auto& dev : devices) {
+                VkPhysicalDeviceProperties props;
+                vkGetPhysicalDeviceProperties(dev, &props);
+                if (strstr(props.deviceName, deviceFilter) != nullptr) {
+                    physicalDevice_ = dev;
+                    deviceName_ = props.deviceName;
+                    printf("  [2/5] GPU selected: %s (filter \"%s\")\n", props.deviceName, deviceFilter);
+                    return;
+                }
+            }
+            throw std::runtime_error(std::string("No Vulkan device matches filter: ") + deviceFilter);
+        }
+
         // Prefer discrete GPU (like RTX 1080)
         for (auto& dev : devices) {
             VkPhysicalDeviceProperties props;
             vkGetPhysicalDeviceProperties(dev, &props);
             if (props.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) {
                 physicalDevice_ = dev;
+                deviceName_ = props.deviceName;
                 printf("  [2/5] GPU selected: %s (discrete)\n", props.deviceName);
                 return;
             }
@@ -116,6 +196,7 @@ private:
         physicalDevice_ = devices[0];
         VkPhysicalDeviceProperties props;
         vkGetPhysicalDeviceProperties(physicalDevice_, &props);
+        deviceName_ = props.deviceName;
         printf("  [2/5] GPU selected: %s (fallback)\n", props.deviceName);
     }
 
@@ -128,9 +209,19 @@ private:
     // Queue Family types:
     //   - Graphics: draw calls
     //   - Compute:  compute shaders  <-- we need this
-    //   - Transfer: memory copy
+    //   - Transfer: memory copy      <-- 스트리밍 업로드용 (비동기)
+    //
+    // Transfer queue 선택 순서:
+    //   1. TRANSFER 전용 family (DMA 엔진, compute와 병렬 실행)
+    //   2. compute family의 compute queue 다음 index
+    //   3. compute queue 공유 (순서만 분리, 병렬성 없음)
+    //
+    // compute queue 여러 개 (computeQueueCount > 1):
+    //   같은 family의 index 0..C-1, transfer가 같은 family면 1개를 남겨 둠
+    //
+    // VK_KHR_push_descriptor가 있으면 활성화 → DescriptorSystem이 push 경로 사용
     // --------------------------------------------------------
-    void createLogicalDevice() {
+    void createLogicalDevice(bool allowPushDescriptors, uint32_t computeQueueCount) {
         // Find compute queue family
         uint32_t queueFamilyCount = 0;
         vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice_, &queueFamilyCount, nullptr);
@@ -149,24 +240,67 @@ private:
             throw std::runtime_error("No compute queue family found");
         }
 
+        // Transfer queue family
+        transferQueueFamily_ = computeQueueFamily_;
+        uint32_t transferQueueIndex = 0;
+        for (uint32_t i = 0; i < queueFamilyCount; i++) {
+            VkQueueFlags flags = queueFamilies[i].queueFlags;
+            if ((flags & VK_QUEUE_TRANSFER_BIT) &&
+                !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+                transferQueueFamily_ = i;
+                break;
+            }
+        }
+        const uint32_t familyQueues = queueFamilies[computeQueueFamily_].queueCount;
+        const bool sharedTransfer = transferQueueFamily_ == computeQueueFamily_;
+        const uint32_t computeLimit = (sharedTransfer && familyQueues > 1) ? familyQueues - 1 : familyQueues;
+        const uint32_t computeCount = std::max(1u, std::min(computeQueueCount, computeLimit));
+        if (sharedTransfer && familyQueues > computeCount) {
+            transferQueueIndex = computeCount;
+        }
+
         // Queue creation info
-        float queuePriority = 1.0f;
+        std::vector<float> queuePriorities(computeCount + 1, 1.0f);
+        std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
         VkDeviceQueueCreateInfo queueCreateInfo{};
         queueCreateInfo.sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
         queueCreateInfo.queueFamilyIndex = computeQueueFamily_;
-        queueCreateInfo.queueCount       = 1;
-        queueCreateInfo.pQueuePriorities = &queuePriority;
+        queueCreateInfo.queueCount       = computeCount + ((sharedTransfer && transferQueueIndex > 0) ? 1 : 0);
+        queueCreateInfo.pQueuePriorities = queuePriorities.data();
+        queueCreateInfos.push_back(queueCreateInfo);
+        if (transferQueueFamily_ != computeQueueFamily_) {
+            queueCreateInfo.queueFamilyIndex = transferQueueFamily_;
+            queueCreateInfo.queueCount       = 1;
+            queueCreateInfos.push_back(queueCreateInfo);
+        }
 
         // Device features (empty for now, add if needed)
         VkPhysicalDeviceFeatures deviceFeatures{};
 
+        // Push descriptor 확장 지원 여부
+        uint32_t extensionCount = 0;
+        vkEnumerateDeviceExtensionProperties(physicalDevice_, nullptr, &extensionCount, nullptr);
+        std::vector<VkExtensionProperties> extensions(extensionCount);
+        vkEnumerateDeviceExtensionProperties(physicalDevice_, nullptr, &extensionCount, extensions.data());
+        bool pushSupported = false;
+        for (const auto& ext : extensions) {
+            if (strcmp(ext.extensionName, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME) == 0) {
+                pushSupported = true;
+                break;
+            }
+        }
+        const bool usePush = allowPushDescriptors && pushSupported;
+        std::vector<const char*> enabledExtensions;
+        if (usePush) enabledExtensions.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+
         // Create logical device
         VkDeviceCreateInfo createInfo{};
         createInfo.sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-        createInfo.queueCreateInfoCount    = 1;
-        createInfo.pQueueCreateInfos       = &queueCreateInfo;
+        createInfo.queueCreateInfoCount    = uint32_t(queueCreateInfos.size());
+        createInfo.pQueueCreateInfos       = queueCreateInfos.data();
         createInfo.pEnabledFeatures        = &deviceFeatures;
-        createInfo.enabledExtensionCount   = 0;  // No swapchain extension needed
+        createInfo.enabledExtensionCount   = uint32_t(enabledExtensions.size());  // No swapchain, push descriptor only
+        createInfo.ppEnabledExtensionNames = enabledExtensions.data();
         createInfo.enabledLayerCount       = 0;
 
         if (vkCreateDevice(physicalDevice_, &createInfo, nullptr, &device_) != VK_SUCCESS) {
@@ -174,8 +308,30 @@ private:
         }
 
         // Get compute queue handle
-        vkGetDeviceQueue(device_, computeQueueFamily_, 0, &computeQueue_);
-        printf("  [3/5] Logical device + compute queue (family %u)\n", computeQueueFamily_);
+        computeQueues_.resize(computeCount);
+        for (uint32_t q = 0; q < computeCount; q++) {
+            vkGetDeviceQueue(device_, computeQueueFamily_, q, &computeQueues_[q]);
+        }
+        computeQueue_ = computeQueues_[0];
+        vkGetDeviceQueue(device_, transferQueueFamily_, transferQueueIndex, &transferQueue_);
+        printf("  [3/5] Logical device + %u compute queue(s) (family %u), transfer queue (family %u, index %u)\n",
+            computeCount, computeQueueFamily_, transferQueueFamily_, transferQueueIndex);
+
+        // Descriptor 시스템 (push descriptor 상한은 Vulkan 1.1+ properties2로 조회)
+        PFN_vkCmdPushDescriptorSetKHR pushFn = nullptr;
+        uint32_t maxPushDescriptors = 0;
+        if (usePush) {
+            VkPhysicalDevicePushDescriptorPropertiesKHR pushProps{};
+            pushProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR;
+            VkPhysicalDeviceProperties2 props2{};
+            props2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            props2.pNext = &pushProps;
+            vkGetPhysicalDeviceProperties2(physicalDevice_, &props2);
+            maxPushDescriptors = pushProps.maxPushDescriptors;
+            pushFn = reinterpret_cast<PFN_vkCmdPushDescriptorSetKHR>(
+                vkGetDeviceProcAddr(device_, "vkCmdPushDescriptorSetKHR"));
+        }
+        initDescriptorSystem(descriptors_, device_, pushFn, maxPushDescriptors);
     }
 
     // --------------------------------------------------------
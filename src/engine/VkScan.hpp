@@ -0,0 +1,93 @@
+// ============================================================
+// File: src/engine/VkScan.hpp
+// Role: GPU exclusive prefix sum (scan.comp) 기록 헬퍼
+// ============================================================
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+
+#include "engine/VkCompute.hpp"
+
+namespace gs {
+
+struct ScanPC {
+    uint32_t mode;        // SCAN_MODE_*
+    uint32_t offset;
+    uint32_t count;
+    uint32_t sumsOffset;
+};
+
+const uint32_t SCAN_MODE_SCAN  = 0;
+const uint32_t SCAN_MODE_ADD   = 1;
+const uint32_t SCAN_BLOCK_SIZE = 512;  // scan.comp BLOCK
+
+// ------------------------------------------------------------
+// ScanPlan: n개 scan에 필요한 level 배치 (한 버퍼 안 uint 위치)
+// ------------------------------------------------------------
+// 예시: n = 300000
+//   level 0: [0, 300000)           → 블록 586개
+//   level 1: [300000, 300586)      → 블록 2개
+//   level 2: [300586, 300588)      → 블록 1개
+//   total  : 300588                (전체 합)
+//   totalSize = 300589 uint
+// level당 블록 수 ≤ 65535 (dispatch X 한도) → n ≤ 약 3300만
+// ------------------------------------------------------------
+struct ScanPlan {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> counts;
+    uint32_t totalOffset = 0;  // scan 후 전체 합 위치
+    uint32_t totalSize   = 0;  // 버퍼에 필요한 uint 수
+};
+
+inline ScanPlan makeScanPlan(uint32_t n) {
+    ScanPlan plan;
+    uint32_t offset = 0;
+    uint32_t count = n;
+    while (true) {
+        plan.offsets.push_back(offset);
+        plan.counts.push_back(count);
+        uint32_t blocks = std::max(1u, (count + SCAN_BLOCK_SIZE - 1) / SCAN_BLOCK_SIZE);
+        uint32_t sumsOffset = offset + count;
+        if (blocks == 1) {
+            plan.totalOffset = sumsOffset;
+            plan.totalSize = sumsOffset + 1;
+            return plan;
+        }
+        offset = sumsOffset;
+        count = blocks;
+    }
+}
+
+inline ComputeContext createScanPipeline(DescriptorSystem& ds, const std::string& shaderDir) {
+    return createComputePipeline(ds, shaderDir + "scan.spv", 1, sizeof(ScanPC));
+}
+
+// ------------------------------------------------------------
+// recordExclusiveScan: data[0, n) → exclusive prefix sum (in-place)
+// ------------------------------------------------------------
+// 호출 전: ctx binding 0에 plan.totalSize 이상 버퍼 바인딩 (bindSSBO),
+//          입력 쓰기 → 이 함수 사이 barrier는 호출자가 기록
+// 호출 후: data[plan.totalOffset] = 전체 합 (barrier 포함)
+// ------------------------------------------------------------
+inline void recordExclusiveScan(VkCommandBuffer cmd, const ComputeContext& ctx, const ScanPlan& plan) {
+    const size_t levels = plan.offsets.size();
+    for (size_t l = 0; l < levels; l++) {
+        uint32_t sums = (l + 1 < levels) ? plan.offsets[l + 1] : plan.totalOffset;
+        ScanPC pc{ SCAN_MODE_SCAN, plan.offsets[l], plan.counts[l], sums };
+        uint32_t blocks = std::max(1u, (plan.counts[l] + SCAN_BLOCK_SIZE - 1) / SCAN_BLOCK_SIZE);
+        recordDispatch(cmd, ctx, &pc, sizeof(pc), blocks);
+        recordComputeBarrier(cmd);
+    }
+    for (size_t l = levels - 1; l-- > 0;) {
+        ScanPC pc{ SCAN_MODE_ADD, plan.offsets[l], plan.counts[l], plan.offsets[l + 1] };
+        uint32_t blocks = (plan.counts[l] + SCAN_BLOCK_SIZE - 1) / SCAN_BLOCK_SIZE;
+        recordDispatch(cmd, ctx, &pc, sizeof(pc), blocks);
+        recordComputeBarrier(cmd);
+    }
+}
+
+} // namespace gs
@@ -0,0 +1,108 @@
+// ============================================================
+// File: src/engine/VkTimer.hpp
+// Role: GPU timestamp query (pass별 소요 시간 측정)
+// ============================================================
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <stdexcept>
+#include <cstdio>
+
+namespace gs {
+
+// ------------------------------------------------------------
+// TimestampPool: VkQueryPool + 변환 계수 묶음
+// ------------------------------------------------------------
+// 사용 패턴 (command buffer 안):
+//   recordTimestampReset(cmd, pool)
+//   recordTimestamp(cmd, pool, 0)
+//   ... dispatch ...
+//   recordTimestamp(cmd, pool, 1)
+// 제출/대기 후:
+//   readTimestampsMs(device, pool, ms)  → ms[1] - ms[0] = pass 시간
+//
+// supported = false면 (timestampValidBits == 0) 기록/읽기 모두 no-op
+// ------------------------------------------------------------
+struct TimestampPool {
+    VkQueryPool pool       = VK_NULL_HANDLE;
+    uint32_t    count      = 0;
+    double      periodNs   = 1.0;   // tick → ns
+    uint64_t    validMask  = ~0ull; // timestampValidBits 마스크
+    bool        supported  = false;
+};
+
+inline TimestampPool createTimestampPool(
+    VkDevice device,
+    VkPhysicalDevice physicalDevice,
+    uint32_t queueFamily,
+    uint32_t count
+) {
+    TimestampPool tp;
+    tp.count = count;
+
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(physicalDevice, &props);
+    tp.periodNs = props.limits.timestampPeriod;
+
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, families.data());
+    uint32_t validBits = families[queueFamily].timestampValidBits;
+    if (validBits == 0) {
+        printf("  [Timer] Timestamps not supported on queue family %u\n", queueFamily);
+        return tp;
+    }
+    tp.validMask = (validBits >= 64) ? ~0ull : ((1ull << validBits) - 1);
+
+    VkQueryPoolCreateInfo info{};
+    info.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    info.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+    info.queryCount = count;
+    if (vkCreateQueryPool(device, &info, nullptr, &tp.pool) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create timestamp query pool");
+    }
+    tp.supported = true;
+    return tp;
+}
+
+inline void destroyTimestampPool(VkDevice device, TimestampPool& tp) {
+    if (tp.pool != VK_NULL_HANDLE) {
+        vkDestroyQueryPool(device, tp.pool, nullptr);
+        tp.pool = VK_NULL_HANDLE;
+    }
+}
+
+// command buffer 시작 직후 1번 (query는 재사용 전 reset 필수)
+inline void recordTimestampReset(VkCommandBuffer cmd, const TimestampPool& tp) {
+    if (!tp.supported) return;
+    vkCmdResetQueryPool(cmd, tp.pool, 0, tp.count);
+}
+
+// 이전 compute 작업이 끝난 시점 기록
+inline void recordTimestamp(VkCommandBuffer cmd, const TimestampPool& tp, uint32_t index) {
+    if (!tp.supported) return;
+    vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, tp.pool, index);
+}
+
+// ------------------------------------------------------------
+// readTimestampsMs: 결과 → ms (첫 timestamp 기준 상대값)
+// ------------------------------------------------------------
+inline bool readTimestampsMs(VkDevice device, const TimestampPool& tp, std::vector<double>& ms) {
+    if (!tp.supported) return false;
+    std::vector<uint64_t> ticks(tp.count);
+    VkResult res = vkGetQueryPoolResults(device, tp.pool, 0, tp.count,
+        ticks.size() * sizeof(uint64_t), ticks.data(), sizeof(uint64_t),
+        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+    if (res != VK_SUCCESS) return false;
+
+    ms.resize(tp.count);
+    for (uint32_t i = 0; i < tp.count; i++) {
+        uint64_t delta = (ticks[i] - ticks[0]) & tp.validMask;
+        ms[i] = double(delta) * tp.periodNs * 1e-6;
+    }
+    return true;
+}
+
+} // namespace gs
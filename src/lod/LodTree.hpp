@@ -0,0 +1,330 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include "common/GaussianTypes.hpp"
+#include "common/Parallel.hpp"
+// ============================================================
+// 파일: src/lod/LodTree.hpp
+// 역할: 대형 장면용 공간 계층 (2D quadtree = 현재 렌더러의 octree) + LOD proxy
+// ============================================================
+//
+// 빌드 (host, 병렬):
+//   1. 가우시안 중심 → 32-bit Morton 코드 (16-bit × 2축) → 정렬
+//      (같은 prefix = 같은 quadtree 셀 → 모든 노드가 연속 구간)
+//   2. 루트 아래 상위 셀들을 스레드별로 나눠 재귀 빌드 → DFS pre-order로 이어붙임
+//   3. 노드마다 proxy 가우시안 1개 = 자식 전체를 moment matching으로 병합
+//
+// GPU에 올리는 평탄 배열:
+//   nodes[]  : LodNode (parent 인덱스, AABB, leaf 구간)
+//   params[] : [Morton 정렬된 원본 N개] + [노드별 proxy (params[N + nodeIndex])]
+//
+// cut 규칙 (lod_mark.comp):
+//   노드 i 선택 ⇔ 화면 안 && (루트 || 부모가 refine) && (accept(i) || leaf)
+//   accept = 투영 크기(AABB 최대 변 × zoom) ≤ lodPixelSize → proxy 1개
+//   leaf인데 accept 아님 → 원본 가우시안 전부
+//   AABB는 자식을 포함하므로 투영 크기는 부모 ≥ 자식 → 부모만 확인하면 충분
+//
+// 블렌딩 순서 = DFS(Morton) 순서. z가 미사용이라 깊이 순서가 없으므로
+// 원본 배열 순서와 겹침 순서가 다를 수 있음 (flat 경로와 픽셀 단위 일치 X)
+// ============================================================
+
+namespace gs {
+
+// ------------------------------------------------------------
+// LodNode: lod_mark/emit.comp와 1:1 (std430, 32 bytes)
+// ------------------------------------------------------------
+struct LodNode {
+    glm::vec2 boundsMin;   // 자식 가우시안 3σ 원을 모두 포함하는 AABB
+    glm::vec2 boundsMax;
+    uint32_t  parent;      // 루트 = LOD_NO_PARENT
+    uint32_t  first;       // leaf: params 안 시작 인덱스
+    uint32_t  count;       // leaf: 가우시안 수, internal: 0
+    uint32_t  depth;
+};
+
+static_assert(sizeof(LodNode) == 32, "LodNode must be 32 bytes");
+
+const uint32_t LOD_NO_PARENT = 0xFFFFFFFFu;
+const uint32_t LOD_MAX_DEPTH = 16;  // Morton 16-bit/축
+
+struct LodBuildConfig {
+    uint32_t leafSize = 8;  // 이 이하면 분할 중지
+    uint32_t threads  = 0;  // 0 = hardware_concurrency
+};
+
+struct LodTree {
+    std::vector<LodNode>       nodes;
+    std::vector<GaussianParam> params;        // 원본 (Morton 순) + proxy
+    uint32_t                   gaussCount = 0; // 원본 수 (proxy 시작 위치)
+    uint32_t                   maxDepth = 0;
+};
+
+// ------------------------------------------------------------
+// Morton: 16-bit x, y → 32-bit 교차 비트 (x = 짝수 비트)
+// ------------------------------------------------------------
+inline uint32_t expandBits16(uint32_t v) {
+    v &= 0x0000FFFFu;
+    v = (v | (v << 8)) & 0x00FF00FFu;
+    v = (v | (v << 4)) & 0x0F0F0F0Fu;
+    v = (v | (v << 2)) & 0x33333333u;
+    v = (v | (v << 1)) & 0x55555555u;
+    return v;
+}
+
+inline uint32_t morton2D(uint32_t x, uint32_t y) {
+    return expandBits16(x) | (expandBits16(y) << 1);
+}
+
+// ------------------------------------------------------------
+// mortonOrder: 중심 xy Morton 순 인덱스 (같은 코드는 원래 순서 유지)
+// ------------------------------------------------------------
+// chunk 파일 / 압축 장면이 공간적으로 뭉친 연속 구간을 만들 때 사용
+// ------------------------------------------------------------
+inline std::vector<uint32_t> mortonOrder(const std::vector<GaussianParam>& gaussians) {
+    const uint32_t N = uint32_t(gaussians.size());
+    glm::vec2 lo(1e30f), hi(-1e30f);
+    for (const auto& g : gaussians) {
+        lo = glm::min(lo, glm::vec2(g.position));
+        hi = glm::max(hi, glm::vec2(g.position));
+    }
+    glm::vec2 extent = glm::max(hi - lo, glm::vec2(1e-6f));
+
+    std::vector<uint64_t> keyed(N);
+    for (uint32_t i = 0; i < N; i++) {
+        glm::vec2 t = (glm::vec2(gaussians[i].position) - lo) / extent;
+        uint32_t qx = uint32_t(std::min(65535.0f, t.x * 65535.0f));
+        uint32_t qy = uint32_t(std::min(65535.0f, t.y * 65535.0f));
+        keyed[i] = (uint64_t(morton2D(qx, qy)) << 32) | i;
+    }
+    std::sort(keyed.begin(), keyed.end());
+
+    std::vector<uint32_t> order(N);
+    for (uint32_t i = 0; i < N; i++) order[i] = uint32_t(keyed[i]);
+    return order;
+}
+
+// ------------------------------------------------------------
+// Proxy 병합 (2D 등방성 moment matching)
+// ------------------------------------------------------------
+// 가중치 w = opacity × σ² (화면에 남기는 "질량")
+//   μ  = Σ w·p / Σ w
+//   σ² = Σ w·(σ_i² + |p_i - μ|²/2) / Σ w     (축당 분산)
+//   색 = Σ w·c / Σ w
+//   opacity = min(1, Σ w / σ²)               (질량 보존)
+// 모멘트는 합성 가능 → 자식 proxy끼리 병합해도 원본 전체 병합과 동일
+// ------------------------------------------------------------
+struct ProxyMoments {
+    double    w = 0.0;
+    glm::dvec2 wp = glm::dvec2(0.0);     // Σ w·p
+    double    wpp = 0.0;                 // Σ w·(σ² + |p|²/2)
+    glm::dvec3 wc = glm::dvec3(0.0);
+
+    void add(const GaussianParam& g) {
+        double s2 = double(g.scale.x) * g.scale.x;
+        double wi = double(g.opacity) * s2;
+        glm::dvec2 p(g.position.x, g.position.y);
+        w   += wi;
+        wp  += wi * p;
+        wpp += wi * (s2 + 0.5 * glm::dot(p, p));
+        wc  += wi * glm::dvec3(g.color);
+    }
+
+    void add(const ProxyMoments& o) {
+        w += o.w; wp += o.wp; wpp += o.wpp; wc += o.wc;
+    }
+
+    GaussianParam toGaussian() const {
+        if (w <= 0.0) {
+            GaussianParam g = makeDefaultGaussian(glm::vec3(0.0f), glm::vec3(0.0f));
+            g.opacity = 0.0f;
+            return g;
+        }
+        glm::dvec2 mu = wp / w;
+        double s2 = std::max(1e-6, wpp / w - 0.5 * glm::dot(mu, mu));
+        GaussianParam g = makeDefaultGaussian(
+            glm::vec3(float(mu.x), float(mu.y), 0.0f), glm::vec3(wc / w));
+        g.scale   = glm::vec3(float(std::sqrt(s2)));
+        g.opacity = float(std::min(1.0, w / s2));
+        return g;
+    }
+};
+
+namespace detail {
+
+struct LodBuilder {
+    const std::vector<GaussianParam>& sorted;
+    const std::vector<uint32_t>&      codes;
+    uint32_t                          leafSize;
+    std::vector<LodNode>              nodes;
+    std::vector<GaussianParam>        proxies;   // nodes와 같은 인덱스
+
+    // [begin, end) 구간 = Morton prefix (depth × 2 bit) 공유
+    // 반환: 이 노드의 모멘트 (부모 proxy 병합용)
+    ProxyMoments build(uint32_t begin, uint32_t end, uint32_t depth, uint32_t parent) {
+        uint32_t self = uint32_t(nodes.size());
+        nodes.push_back(LodNode{});
+        proxies.push_back(GaussianParam{});
+        nodes[self].parent = parent;
+        nodes[self].depth  = depth;
+
+        ProxyMoments m;
+        glm::vec2 bmin(1e30f), bmax(-1e30f);
+
+        if (end - begin <= leafSize || depth >= LOD_MAX_DEPTH) {
+            nodes[self].first = begin;
+            nodes[self].count = end - begin;
+            for (uint32_t i = begin; i < end; i++) {
+                const GaussianParam& g = sorted[i];
+                glm::vec2 c(g.position.x, g.position.y);
+                float r = 3.0f * g.scale.x;
+                bmin = glm::min(bmin, c - r);
+                bmax = glm::max(bmax, c + r);
+                m.add(g);
+            }
+        } else {
+            // 다음 2 bit로 4분할 (codes는 정렬되어 있으므로 이진 탐색)
+            uint32_t shift = 2 * (LOD_MAX_DEPTH - 1 - depth);
+            uint32_t lo = begin;
+            for (uint32_t q = 0; q < 4; q++) {
+                uint32_t hi = (q == 3) ? end : uint32_t(std::partition_point(
+                    codes.begin() + lo, codes.begin() + end,
+                    [&](uint32_t c) { return ((c >> shift) & 3u) <= q; }) - codes.begin());
+                if (hi > lo) {
+                    uint32_t child = uint32_t(nodes.size());
+                    m.add(build(lo, hi, depth + 1, self));
+                    bmin = glm::min(bmin, nodes[child].boundsMin);
+                    bmax = glm::max(bmax, nodes[child].boundsMax);
+                }
+                lo = hi;
+            }
+        }
+        nodes[self].boundsMin = bmin;
+        nodes[self].boundsMax = bmax;
+        proxies[self] = m.toGaussian();
+        return m;
+    }
+};
+
+} // namespace detail
+
+// ------------------------------------------------------------
+// buildLodTree: 평탄 배열 생성 (GPU 업로드용)
+// ------------------------------------------------------------
+// 루트를 depth 2 (최대 16셀)까지 미리 나눠 셀마다 스레드 1개
+// 각 서브트리는 로컬 배열에 DFS로 만든 뒤 인덱스 보정해서 이어붙임
+// ------------------------------------------------------------
+inline LodTree buildLodTree(const std::vector<GaussianParam>& gaussians, const LodBuildConfig& cfg = {}) {
+    LodTree tree;
+    const uint32_t N = uint32_t(gaussians.size());
+    tree.gaussCount = N;
+    if (N == 0) return tree;
+
+    const uint32_t threadCount = defaultThreadCount(cfg.threads);
+
+    // ---------- 1. Morton 코드 (병렬) + 정렬 ----------
+    glm::vec2 lo(1e30f), hi(-1e30f);
+    for (const auto& g : gaussians) {
+        lo = glm::min(lo, glm::vec2(g.position));
+        hi = glm::max(hi, glm::vec2(g.position));
+    }
+    glm::vec2 extent = glm::max(hi - lo, glm::vec2(1e-6f));
+
+    std::vector<uint64_t> keyed(N);  // (code << 32) | index → 같은 코드는 원래 순서 유지
+    parallelFor(N, threadCount, [&](uint32_t i) {
+        glm::vec2 t = (glm::vec2(gaussians[i].position) - lo) / extent;
+        uint32_t qx = uint32_t(std::min(65535.0f, t.x * 65535.0f));
+        uint32_t qy = uint32_t(std::min(65535.0f, t.y * 65535.0f));
+        keyed[i] = (uint64_t(morton2D(qx, qy)) << 32) | i;
+    });
+    std::sort(keyed.begin(), keyed.end());
+
+    std::vector<GaussianParam> sorted(N);
+    std::vector<uint32_t> codes(N);
+    parallelFor(N, threadCount, [&](uint32_t i) {
+        sorted[i] = gaussians[uint32_t(keyed[i])];
+        codes[i]  = uint32_t(keyed[i] >> 32);
+    });
+
+    // ---------- 2. 상위 셀 (depth 2, 16개) 서브트리 병렬 빌드 ----------
+    const uint32_t SPLIT_DEPTH = 2;
+    const uint32_t cellCount = 1u << (2 * SPLIT_DEPTH);
+    const uint32_t cellShift = 32 - 2 * SPLIT_DEPTH;
+    std::vector<uint32_t> cellBegin(cellCount + 1, N);
+    for (uint32_t c = 0; c < cellCount; c++) {
+        cellBegin[c] = uint32_t(std::lower_bound(codes.begin(), codes.end(), c << cellShift,
+            [](uint32_t a, uint32_t b) { return a < b; }) - codes.begin());
+    }
+
+    std::vector<detail::LodBuilder> builders;
+    builders.reserve(cellCount);
+    for (uint32_t c = 0; c < cellCount; c++) builders.push_back({ sorted, codes, cfg.leafSize, {}, {} });
+    std::vector<ProxyMoments> cellMoments(cellCount);
+
+    const bool singleLeaf = (N <= cfg.leafSize);
+    if (!singleLeaf) {
+        parallelFor(cellCount, threadCount, [&](uint32_t c) {
+            if (cellBegin[c + 1] > cellBegin[c]) {
+                cellMoments[c] = builders[c].build(cellBegin[c], cellBegin[c + 1], SPLIT_DEPTH, 0);
+            }
+        });
+    }
+
+    // ---------- 3. 이어붙이기: 루트 → depth 1 (4개) → depth 2 서브트리 ----------
+    std::vector<LodNode>& nodes = tree.nodes;
+    std::vector<GaussianParam> proxies;
+
+    auto appendNode = [&](const LodNode& n, const GaussianParam& proxy) {
+        nodes.push_back(n);
+        proxies.push_back(proxy);
+        return uint32_t(nodes.size() - 1);
+    };
+
+    if (singleLeaf) {
+        detail::LodBuilder b{ sorted, codes, cfg.leafSize, {}, {} };
+        b.build(0, N, 0, LOD_NO_PARENT);
+        nodes = b.nodes;
+        proxies = b.proxies;
+    } else {
+        uint32_t root = appendNode(LodNode{ glm::vec2(1e30f), glm::vec2(-1e30f), LOD_NO_PARENT, 0, 0, 0 },
+                                   GaussianParam{});
+        ProxyMoments rootM;
+        for (uint32_t q = 0; q < 4; q++) {
+            ProxyMoments qM;
+            bool any = false;
+            for (uint32_t s = 0; s < 4; s++) any |= (cellBegin[q * 4 + s + 1] > cellBegin[q * 4 + s]);
+            if (!any) continue;
+
+            uint32_t mid = appendNode(LodNode{ glm::vec2(1e30f), glm::vec2(-1e30f), root, 0, 0, 1 },
+                                      GaussianParam{});
+            for (uint32_t s = 0; s < 4; s++) {
+                uint32_t c = q * 4 + s;
+                if (cellBegin[c + 1] <= cellBegin[c]) continue;
+                uint32_t base = uint32_t(nodes.size());
+                for (size_t k = 0; k < builders[c].nodes.size(); k++) {
+                    LodNode n = builders[c].nodes[k];
+                    n.parent = (k == 0) ? mid : n.parent + base;
+                    appendNode(n, builders[c].proxies[k]);
+                }
+                nodes[mid].boundsMin = glm::min(nodes[mid].boundsMin, nodes[base].boundsMin);
+                nodes[mid].boundsMax = glm::max(nodes[mid].boundsMax, nodes[base].boundsMax);
+                qM.add(cellMoments[c]);
+            }
+            proxies[mid] = qM.toGaussian();
+            nodes[root].boundsMin = glm::min(nodes[root].boundsMin, nodes[mid].boundsMin);
+            nodes[root].boundsMax = glm::max(nodes[root].boundsMax, nodes[mid].boundsMax);
+            rootM.add(qM);
+        }
+        proxies[root] = rootM.toGaussian();
+    }
+
+    // ---------- 평탄 params = 원본 (Morton 순) + proxy ----------
+    tree.params = std::move(sorted);
+    tree.params.insert(tree.params.end(), proxies.begin(), proxies.end());
+    for (const auto& n : nodes) tree.maxDepth = std::max(tree.maxDepth, n.depth);
+    return tree;
+}
+
+}
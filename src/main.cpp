@@ -6,86 +6,107 @@
 #include <cstdio>
 #include <vector>
 #include <cmath>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
 
 #include "common/GaussianTypes.hpp"
+#include "common/CpuReference.hpp"
+#include "common/SceneIO.hpp"
 #include "engine/VkEngine.hpp"
 #include "engine/VkBuffer.hpp"
 #include "engine/VkCompute.hpp"
+#include "train/TrainPasses.hpp"
 #include "utils/ImageIO.hpp"
 
 // ============================================================
-// Push Constants
+// Coarse-to-fine 해상도 스케줄
 // ============================================================
-struct RenderPC {
-    uint32_t width;
-    uint32_t height;
-    uint32_t gaussCount;
-};
-
-struct LossPC {
-    uint32_t width;
-    uint32_t height;
+// level 3 = 1/8, 2 = 1/4, 1 = 1/2, 0 = full
+// 초반엔 위치가 크게 움직이므로 저해상도로 충분 → 픽셀 수 1/64까지 절약
+// untilIter: 이 iteration 전까지 해당 level 사용
+// ------------------------------------------------------------
+struct ResolutionStage {
+    int      untilIter;
+    uint32_t level;
 };
 
 // ============================================================
-// GaussianGrad
+// 학습 옵션 (stochastic 샘플링 / backward 누적 방식)
 // ============================================================
-struct GaussianGrad {
-    glm::vec3 dPosition;
-    float     dOpacity;
-    glm::vec3 dScale;
-    float     _pad0;
-    glm::vec4 dRotation;
-    glm::vec3 dColor;
-    float     _pad1;
-};
-static_assert(sizeof(GaussianGrad) == 64, "GaussianGrad must be 64 bytes");
-
-struct GaussianGradInt {
-    glm::ivec3 dPosition;   int dOpacity;
-    glm::ivec3 dScale;      int _pad0;
-    glm::ivec4 dRotation;
-    glm::ivec3 dColor;      int _pad1;
+//   --sample-tiles K     매 iteration 16×16 타일 K개만 학습
+//   --sample-crop WxH    매 iteration W×H 타일 크기 random crop 1개만 학습
+//   --sample-seed N      타일 RNG seed (기본 1234)
+//   --grad-mode M        atomic (기본) | deterministic (고정 순서 float 합산)
+// 타일 격자가 K (crop 크기) 이하인 저해상도 level은 전체 이미지로 학습
+// 한 step 타일 수 상한 SAMPLE_MAX_TILES (16383, indirect dispatch 한계)
+// ------------------------------------------------------------
+struct TrainOptions {
+    uint32_t     mode       = gs::SAMPLE_NONE;
+    uint32_t     tileCount  = 0;
+    uint32_t     cropTilesX = 0;
+    uint32_t     cropTilesY = 0;
+    uint32_t     seed       = 1234;
+    gs::GradMode gradMode   = gs::GRAD_ATOMIC;
+    uint32_t     oitIters   = 0;  // 처음 K iteration은 BLEND_OIT (전체 이미지 + atomic step만)
+    bool         fused      = false;  // 전체 이미지 정렬 step을 train_fused.comp 1 dispatch로
 };
 
-static_assert(sizeof(GaussianGradInt) == 64, "GaussianGradInt must be 64 bytes");
-
-const float GRAD_SCALE = 1000000.0f;
-// ============================================================
-// CPU에서 가우시안 렌더링 (target 생성용)
-// ============================================================
-void renderGaussiansCPU(
-    std::vector<glm::vec4>& pixels,
-    const std::vector<gs::GaussianParam>& gaussians,
-    uint32_t width, uint32_t height
-) {
-    for (uint32_t y = 0; y < height; y++) {
-        for (uint32_t x = 0; x < width; x++) {
-            glm::vec2 pixelPos(x + 0.5f, y + 0.5f);
-            
-            glm::vec3 colorAccum(0.0f);
-            float T = 1.0f;
-            
-            for (const auto& g : gaussians) {
-                glm::vec2 center(g.position.x, g.position.y);
-                glm::vec2 diff = pixelPos - center;
-                float r2 = glm::dot(diff, diff);
-                float sigma2 = g.scale.x * g.scale.x;
-                float gaussian = std::exp(-0.5f * r2 / sigma2);
-                float alpha = gaussian * g.opacity;
-                
-                colorAccum += g.color * alpha * T;
-                T *= (1.0f - alpha);
-                
-                if (T < 0.001f) break;
+static TrainOptions parseTrainOptions(int argc, char** argv) {
+    TrainOptions opt;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        if (i + 1 >= argc) {
+            printf("[Warn] Missing value for %s\n", a.c_str());
+            break;
+        }
+        const char* v = argv[++i];
+        if (a == "--sample-tiles") {
+            opt.mode = gs::SAMPLE_TILES;
+            opt.tileCount = uint32_t(std::max(1, std::atoi(v)));
+            if (opt.tileCount > gs::SAMPLE_MAX_TILES) {
+                printf("[Warn] --sample-tiles %u exceeds %u tiles per step, clamped\n",
+                    opt.tileCount, gs::SAMPLE_MAX_TILES);
+            }
+        } else if (a == "--sample-crop") {
+            unsigned cx = 0, cy = 0;
+            if (std::sscanf(v, "%ux%u", &cx, &cy) != 2 || cx == 0 || cy == 0) {
+                printf("[Warn] --sample-crop expects WxH (tiles), got %s\n", v);
+                continue;
+            }
+            opt.mode = gs::SAMPLE_CROP;
+            opt.cropTilesX = cx;
+            opt.cropTilesY = cy;
+            if (uint64_t(cx) * cy > gs::SAMPLE_MAX_TILES) {
+                printf("[Warn] --sample-crop %ux%u exceeds %u tiles per step, height clamped\n",
+                    cx, cy, gs::SAMPLE_MAX_TILES);
+            }
+        } else if (a == "--sample-seed") {
+            opt.seed = uint32_t(std::atoi(v));
+        } else if (a == "--grad-mode") {
+            std::string m = v;
+            if (m == "atomic") {
+                opt.gradMode = gs::GRAD_ATOMIC;
+            } else if (m == "deterministic") {
+                opt.gradMode = gs::GRAD_DETERMINISTIC;
+            } else {
+                printf("[Warn] --grad-mode expects atomic|deterministic, got %s\n", v);
             }
-            
-            pixels[y * width + x] = glm::vec4(colorAccum, 1.0f);
+        } else if (a == "--fused") {
+            opt.fused = std::atoi(v) != 0;
+        } else if (a == "--oit-iters") {
+            opt.oitIters = uint32_t(std::max(0, std::atoi(v)));
+        } else {
+            printf("[Warn] Unknown option %s\n", a.c_str());
         }
     }
+    return opt;
 }
 
-int main() {
+int main(int argc, char** argv) {
+    const TrainOptions trainOpt = parseTrainOptions(argc, argv);
+
     // ============================================================
     // 설정
     // ============================================================
@@ -93,11 +114,11 @@ int main() {
     const uint32_t IMG_H = 64;
     const uint32_t pixelCount = IMG_W * IMG_H;
     const uint32_t GAUSS_COUNT = 3;  // N개 가우시안
-    
+    const uint32_t PYRAMID_LEVELS = 4;  // full, 1/2, 1/4, 1/8
+
     const VkDeviceSize imageSize = pixelCount * sizeof(glm::vec4);
-    const VkDeviceSize lossSize = pixelCount * sizeof(float);
     const VkDeviceSize paramsSize = GAUSS_COUNT * sizeof(gs::GaussianParam);
-    const VkDeviceSize gradsSize = GAUSS_COUNT * sizeof(GaussianGrad);
+    const VkDeviceSize gradsSize = GAUSS_COUNT * sizeof(gs::GaussianGrad);
 
     // ============================================================
     // GLFW + Vulkan
@@ -113,12 +134,8 @@ int main() {
     // Pipelines
     // ============================================================
     printf("\n=== Create Pipelines ===\n");
-    gs::ComputeContext renderPipeline = gs::createComputePipeline(
-        engine.device(), "../src/shaders/gaussian.spv", 2, sizeof(RenderPC));
-    gs::ComputeContext lossPipeline = gs::createComputePipeline(
-        engine.device(), "../src/shaders/loss.spv", 3, sizeof(LossPC));
-    gs::ComputeContext backwardPipeline = gs::createComputePipeline(
-        engine.device(), "../src/shaders/backward.spv", 4, sizeof(RenderPC));
+    gs::TrainPipelines pipes = gs::createTrainPipelines(engine, "../src/shaders/");
+
     // ============================================================
     // Target 가우시안 (학습 목표)
     // ============================================================
@@ -132,9 +149,9 @@ int main() {
         g.scale = glm::vec3(8.0f);
         g.opacity = 1.0f;
     }
-    
+
     std::vector<glm::vec4> targetPixels(pixelCount);
-    renderGaussiansCPU(targetPixels, targetGaussians, IMG_W, IMG_H);
+    gs::renderGaussiansCPU(targetPixels, targetGaussians, IMG_W, IMG_H);
 
 
     // ============================================================
@@ -154,47 +171,42 @@ int main() {
     // 버퍼 생성
     // ============================================================
     printf("\n=== Create Buffers ===\n");
-    
-    gs::BufferBundle paramsBuf = gs::createBuffer(
-        engine.device(), engine.physicalDevice(),
-        paramsSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    
-    gs::BufferBundle gradsBuf = gs::createBuffer(
-        engine.device(), engine.physicalDevice(),
-        gradsSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    
-    gs::BufferBundle renderedBuf = gs::createBuffer(
-        engine.device(), engine.physicalDevice(),
-        imageSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    
-    gs::BufferBundle targetBuf = gs::createBuffer(
-        engine.device(), engine.physicalDevice(),
-        imageSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    gs::uploadToBuffer(engine.device(), targetBuf, targetPixels.data(), imageSize);
-    
-    gs::BufferBundle lossBuf = gs::createBuffer(
-        engine.device(), engine.physicalDevice(),
-        lossSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    gs::TrainBuffers bufs = gs::createTrainBuffers(
+        engine.device(), engine.physicalDevice(), GAUSS_COUNT, IMG_W, IMG_H, trainOpt.gradMode);
+
+    // Target 피라미드: level 0 = CPU 업로드, 나머지는 GPU에서 downsample
+    std::vector<gs::BufferBundle> targetPyramid(PYRAMID_LEVELS);
+    std::vector<uint32_t> levelW(PYRAMID_LEVELS), levelH(PYRAMID_LEVELS);
+    for (uint32_t l = 0; l < PYRAMID_LEVELS; l++) {
+        levelW[l] = std::max(1u, IMG_W >> l);
+        levelH[l] = std::max(1u, IMG_H >> l);
+        VkMemoryPropertyFlags memProps = (l == 0)
+            ? (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+            : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        targetPyramid[l] = gs::createBuffer(
+            engine.device(), engine.physicalDevice(),
+            levelW[l] * levelH[l] * sizeof(glm::vec4), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            memProps);
+    }
+    gs::uploadToBuffer(engine.device(), targetPyramid[0], targetPixels.data(), imageSize);
 
     // ============================================================
-    // Descriptor 바인딩
+    // Target 피라미드 생성 (view당 1회)
     // ============================================================
-    gs::bindSSBO(engine.device(), renderPipeline, paramsBuf.buffer, paramsBuf.size, 0);
-    gs::bindSSBO(engine.device(), renderPipeline, renderedBuf.buffer, renderedBuf.size, 1);
-    
-    gs::bindSSBO(engine.device(), lossPipeline, renderedBuf.buffer, renderedBuf.size, 0);
-    gs::bindSSBO(engine.device(), lossPipeline, targetBuf.buffer, targetBuf.size, 1);
-    gs::bindSSBO(engine.device(), lossPipeline, lossBuf.buffer, lossBuf.size, 2);
-
-    gs::bindSSBO(engine.device(), backwardPipeline, paramsBuf.buffer, paramsBuf.size, 0); 
-    gs::bindSSBO(engine.device(), backwardPipeline, gradsBuf.buffer, gradsBuf.size, 1);
-    gs::bindSSBO(engine.device(), backwardPipeline, renderedBuf.buffer, renderedBuf.size,2);
-    gs::bindSSBO(engine.device(), backwardPipeline, targetBuf.buffer, targetBuf.size, 3);
+    // render/loss/backward 버퍼는 full 크기로 1번만 할당,
+    // 각 level은 앞쪽 levelW × levelH 영역만 사용
+    // ------------------------------------------------------------
+    VkCommandBuffer cmd = engine.commandBuffer();
+    gs::buildTargetPyramid(engine, pipes, cmd, targetPyramid, levelW, levelH);
+    printf("[OK] Target pyramid: %u levels (%ux%u → %ux%u)\n", PYRAMID_LEVELS,
+        levelW[0], levelH[0], levelW[PYRAMID_LEVELS - 1], levelH[PYRAMID_LEVELS - 1]);
+
+    // ============================================================
+    // 버퍼 바인딩
+    // ============================================================
+    // target (loss binding 1)은 level 전환 시 다시 바인딩
+    gs::bindTrainBuffers(pipes, bufs);
+
     // ============================================================
     // 학습 루프
     // ============================================================
@@ -202,88 +214,93 @@ int main() {
     const int MAX_ITER = 200;
     const float colorLR = 0.3f;
     const float posLR = 30.0f;
-    
-    VkCommandBuffer cmd = engine.commandBuffer();
-    
+    const float SSIM_WEIGHT = 0.2f;  // INRIA 3DGS 기본값
+
+    // 1/8 → 1/4 → 1/2 → full (마지막 stage는 반드시 level 0)
+    const ResolutionStage SCHEDULE[] = {
+        { MAX_ITER / 8, 3 },
+        { MAX_ITER / 4, 2 },
+        { MAX_ITER / 2, 1 },
+        { MAX_ITER,     0 },
+    };
+    size_t stage = 0;
+    uint32_t level = UINT32_MAX;
+
     for (int iter = 0; iter < MAX_ITER; iter++) {
+        // ---------- 해상도 level 전환 ----------
+        while (iter >= SCHEDULE[stage].untilIter) stage++;
+        if (SCHEDULE[stage].level != level) {
+            level = SCHEDULE[stage].level;
+            // binding은 기록 시점에 고정 → 다음 기록부터 새 target
+            gs::bindTarget(pipes, targetPyramid[level]);
+            printf("--- Level %u: %ux%u (iter %d) ---\n", level, levelW[level], levelH[level], iter);
+        }
+        const uint32_t curW = levelW[level];
+        const uint32_t curH = levelH[level];
+        const float pixelScale = float(1u << level);
+
+        // ---------- Stochastic 샘플링 여부 ----------
+        gs::SamplePC samplePC{ curW, curH, trainOpt.seed, uint32_t(iter), trainOpt.mode,
+            trainOpt.tileCount, trainOpt.cropTilesX, trainOpt.cropTilesY };
+        const uint32_t sampledTiles = gs::sampledTileCount(samplePC);
+        const uint32_t sampled = (sampledTiles > 0) ? trainOpt.mode : gs::SAMPLE_NONE;
+
+        // loss 합산 / gradient 정규화 기준 = 이번 step에 실제 학습한 픽셀 수
+        const uint32_t curPixels = (sampled != gs::SAMPLE_NONE)
+            ? sampledTiles * gs::SAMPLE_TILE * gs::SAMPLE_TILE
+            : curW * curH;
+
         // ---------- 파라미터 업로드 ----------
-        gs::uploadToBuffer(engine.device(), paramsBuf, gaussians.data(), paramsSize);
-        std::vector<GaussianGradInt> zeroGrads(GAUSS_COUNT, GaussianGradInt{});
-        gs::uploadToBuffer(engine.device(), gradsBuf, zeroGrads.data(), gradsSize);
+        gs::uploadToBuffer(engine.device(), bufs.params, gaussians.data(), paramsSize);
+        if (bufs.gradMode == gs::GRAD_ATOMIC) {
+            // atomic 누적 → 0 초기화 필요 (deterministic은 grad_reduce가 덮어씀)
+            std::vector<gs::GaussianGradInt> zeroGrads(GAUSS_COUNT, gs::GaussianGradInt{});
+            gs::uploadToBuffer(engine.device(), bufs.grads, zeroGrads.data(), gradsSize);
+        }
 
         // ---------- Command Buffer ----------
-        VkCommandBufferBeginInfo beginInfo{};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        vkBeginCommandBuffer(cmd, &beginInfo);
-        
-        // Forward
-        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, renderPipeline.pipeline);
-        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE,
-            renderPipeline.pipelineLayout, 0, 1, &renderPipeline.descriptorSet, 0, nullptr);
-        RenderPC renderPC{ IMG_W, IMG_H, GAUSS_COUNT };
-        vkCmdPushConstants(cmd, renderPipeline.pipelineLayout,
-            VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(renderPC), &renderPC);
-        vkCmdDispatch(cmd, IMG_W / 8, IMG_H / 8, 1);
-        
-        // Barrier
-        VkMemoryBarrier barrier{};
-        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
-        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
-        
-        // Loss
-        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, lossPipeline.pipeline);
-        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE,
-            lossPipeline.pipelineLayout, 0, 1, &lossPipeline.descriptorSet, 0, nullptr);
-        LossPC lossPC{ IMG_W, IMG_H };
-        vkCmdPushConstants(cmd, lossPipeline.pipelineLayout,
-            VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(lossPC), &lossPC);
-        vkCmdDispatch(cmd, IMG_W / 8, IMG_H / 8, 1);
-        
-        // Backward
-        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, backwardPipeline.pipeline);
-        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE,
-            backwardPipeline.pipelineLayout, 0, 1, &backwardPipeline.descriptorSet, 0, nullptr);
-        vkCmdPushConstants(cmd, backwardPipeline.pipelineLayout,
-            VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(renderPC), &renderPC);
-        vkCmdDispatch(cmd, IMG_W / 8, IMG_H / 8, 1);
-        
+        // 초기 iteration은 정렬 없는 근사 합성 (OIT는 atomic 누적만 지원)
+        const gs::BlendMode blend = (uint32_t(iter) < trainOpt.oitIters && bufs.gradMode == gs::GRAD_ATOMIC)
+            ? gs::BLEND_OIT : gs::BLEND_SORTED;
+        // 융합 step: 전체 이미지 + atomic + 정렬 합성 + (SSIM이면) shared memory 충분
+        const bool fused = trainOpt.fused && sampled == gs::SAMPLE_NONE && blend == gs::BLEND_SORTED &&
+            bufs.gradMode == gs::GRAD_ATOMIC && (pipes.fusedSsim || SSIM_WEIGHT == 0.0f);
+        gs::beginOneTimeCommands(cmd);
+        gs::RenderPC renderPC{ curW, curH, GAUSS_COUNT, pixelScale, sampled };
+        gs::LossPC lossPC{ curW, curH, SSIM_WEIGHT, sampled };
+        if (sampled != gs::SAMPLE_NONE) {
+            gs::recordTrainStepSampled(cmd, pipes, bufs, samplePC, renderPC, lossPC);
+        } else if (fused) {
+            gs::FusedPC fusedPC{ curW, curH, GAUSS_COUNT, pixelScale, SSIM_WEIGHT, 0 };
+            gs::recordTrainStepFused(cmd, pipes, bufs, fusedPC);  // 타일별 forward → loss → backward
+        } else {
+            gs::recordTrainStep(cmd, pipes, bufs, renderPC, lossPC, blend);  // forward → loss → backward
+        }
         vkEndCommandBuffer(cmd);
 
         // Processing ++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        // Submit
-        VkSubmitInfo submitInfo{};
-        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &cmd;
-        vkQueueSubmit(engine.computeQueue(), 1, &submitInfo, VK_NULL_HANDLE);
-        vkQueueWaitIdle(engine.computeQueue());
+        engine.submitAndWait(cmd);
         // Processing ------------------------------------------------------
-        
+
         // ---------- Loss 합산 ----------
-        std::vector<float> pixelLoss(pixelCount);
-        gs::downloadFromBuffer(engine.device(), lossBuf, pixelLoss.data(), lossSize);
         float totalLoss = 0.0f;
-        for (float l : pixelLoss) totalLoss += l;
-        
-        // ---------- Gradient 계산 (CPU) ----------
-        std::vector<glm::vec4> rendered(pixelCount);
-        gs::downloadFromBuffer(engine.device(), renderedBuf, rendered.data(), imageSize);
-
-        std::vector<GaussianGradInt> gradsInt(GAUSS_COUNT); 
-        gs::downloadFromBuffer(engine.device(), gradsBuf, gradsInt.data(), gradsSize);
-
-        // gradient 초기화
-        std::vector<glm::vec3> dColors(GAUSS_COUNT, glm::vec3(0.0f));
-        std::vector<glm::vec2> dPositions(GAUSS_COUNT, glm::vec2(0.0f));
-        
+        if (fused) {
+            totalLoss = gs::readFusedLoss(engine.device(), bufs, curW, curH);
+        } else {
+            std::vector<float> pixelLoss(curPixels);
+            gs::downloadFromBuffer(engine.device(), bufs.loss, pixelLoss.data(), curPixels * sizeof(float));
+            for (float l : pixelLoss) totalLoss += l;
+        }
+
+        // ---------- Gradient 적용 (CPU) ----------
+        std::vector<gs::GaussianGrad> grads;
+        gs::readGradients(engine.device(), bufs, GAUSS_COUNT, grads);
+
+        // 학습한 픽셀 수로 정규화 (level / 샘플링 여부와 무관하게 gradient 크기 일정)
         for (uint32_t i = 0; i < GAUSS_COUNT; i++) {
-            glm::vec3 dColor = glm::vec3(gradsInt[i].dColor) / GRAD_SCALE / float(pixelCount);
-            glm::vec2 dPos = glm::vec2(gradsInt[i].dPosition) / GRAD_SCALE / float(pixelCount);
-            
+            glm::vec3 dColor = grads[i].dColor / float(curPixels);
+            glm::vec2 dPos = glm::vec2(grads[i].dPosition) / float(curPixels);
+
             gaussians[i].color -= colorLR * dColor;
             gaussians[i].color = glm::clamp(gaussians[i].color, glm::vec3(0.0f), glm::vec3(1.0f));
             gaussians[i].position.x -= posLR * dPos.x;
@@ -292,14 +309,14 @@ int main() {
 
         // ---------- 로그 ----------
         if (iter % 20 == 0 || iter == MAX_ITER - 1) {
-            printf("Iter %3d | Loss: %.2f\n", iter, totalLoss);
+            printf("Iter %3d | L%u | Loss: %.2f (%u px)\n", iter, level, totalLoss, curPixels);
             for (uint32_t i = 0; i < GAUSS_COUNT; i++) {
                 printf("  G%u: Color(%.2f,%.2f,%.2f) Pos(%.1f,%.1f)\n", i,
                     gaussians[i].color.r, gaussians[i].color.g, gaussians[i].color.b,
                     gaussians[i].position.x, gaussians[i].position.y);
             }
         }
-        
+
         vkResetCommandBuffer(cmd, 0);
     }
 
@@ -307,24 +324,30 @@ int main() {
     // 결과 저장
     // ============================================================
     printf("\n=== Save Results ===\n");
+    if (trainOpt.mode != gs::SAMPLE_NONE || trainOpt.fused) {
+        // 샘플 모드는 rendered가 마지막 샘플 타일만 갱신됨, 융합 step은 rendered를 안 씀 → 전체 다시 렌더
+        gs::uploadToBuffer(engine.device(), bufs.params, gaussians.data(), paramsSize);
+        gs::beginOneTimeCommands(cmd);
+        gs::RenderPC renderPC{ IMG_W, IMG_H, GAUSS_COUNT, 1.0f, gs::SAMPLE_NONE };
+        gs::recordForward(cmd, pipes, renderPC);
+        vkEndCommandBuffer(cmd);
+        engine.submitAndWait(cmd);
+        vkResetCommandBuffer(cmd, 0);
+    }
     std::vector<glm::vec4> finalImage(pixelCount);
-    gs::downloadFromBuffer(engine.device(), renderedBuf, finalImage.data(), imageSize);
+    gs::downloadFromBuffer(engine.device(), bufs.rendered, finalImage.data(), imageSize);
     gs::savePPM("../ppmOutput/final.ppm", finalImage, IMG_W, IMG_H);
+    gs::saveScene("../ppmOutput/scene.gsplat", gs::Scene{ gaussians, IMG_W, IMG_H });  // gaussian_serve 입력
 
     // ============================================================
     // Cleanup
     // ============================================================
-    gs::destroyBuffer(engine.device(), paramsBuf);
-    gs::destroyBuffer(engine.device(), gradsBuf);
-    gs::destroyBuffer(engine.device(), renderedBuf);
-    gs::destroyBuffer(engine.device(), targetBuf);
-    gs::destroyBuffer(engine.device(), lossBuf);
-
-    gs::destroyComputePipeline(engine.device(), renderPipeline);
-    gs::destroyComputePipeline(engine.device(), lossPipeline);
-    gs::destroyComputePipeline(engine.device(), backwardPipeline);
+    gs::destroyTrainBuffers(engine.device(), bufs);
+    for (auto& buf : targetPyramid) gs::destroyBuffer(engine.device(), buf);
+
+    gs::destroyTrainPipelines(engine.device(), pipes);
     engine.cleanup();
-    
+
     glfwDestroyWindow(window);
     glfwTerminate();
     return 0;
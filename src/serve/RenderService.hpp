@@ -0,0 +1,504 @@
+// ============================================================
+// File: src/serve/RenderService.hpp
+// Role: 렌더 전용 서비스 - 장면 상주 + 카메라 batch 렌더 + pinned readback
+// ============================================================
+//
+// 학습 루프와 독립된 렌더 경로:
+//   params   : DEVICE_LOCAL (staging 1회 업로드 후 상주)
+//   views    : HOST_VISIBLE (batch마다 카메라 기록, persistent map)
+//   output   : DEVICE_LOCAL (RGBA8, batch 전체 view 연속 배치)
+//   readback : HOST_VISIBLE (+HOST_CACHED 가능 시) persistent map
+//              → GPU가 vkCmdCopyBuffer로 채우고 host는 map 포인터에서 바로 인코딩
+//
+// batch 1회 = dispatch 1번 (workgroup.z = view) + copy 1번 + 제출 1번
+//
+// LOD 모드 (cfg.lod): 장면 대신 LodTree 평탄 배열 상주
+//   view마다 lod_mark → scan → lod_emit 로 cut 선택 → render_views가 cut만 순회
+//   렌더 비용 ∝ 화면 픽셀 × cut 크기 (cut ≈ 화면 면적 / lodPixelSize², 장면 크기와 무관)
+//
+// 스트리밍 모드 (cfg.streamPath): 장면은 .gschunk 파일에 두고 GPU에는 chunk pool만
+//   view마다 host가 가시 chunk 목록 작성 → ChunkResidency가 miss chunk 업로드
+//   render_views는 residency table로 chunk → pool slot 간접 참조
+//
+// 압축 모드 (compressed != nullptr): CompressedScene 배열을 변환 없이 그대로 상주
+//   render_views가 가우시안마다 codebook/양자화 위치를 직접 디코드 (8 bytes/가우시안)
+// ============================================================
+#pragma once
+
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cmath>
+
+#include "common/GaussianTypes.hpp"
+#include "engine/VkEngine.hpp"
+#include "engine/VkBuffer.hpp"
+#include "engine/VkCompute.hpp"
+#include "engine/VkTimer.hpp"
+#include "engine/VkScan.hpp"
+#include "lod/LodTree.hpp"
+#include "stream/ChunkResidency.hpp"
+#include "compress/CompressedScene.hpp"
+
+namespace gs {
+
+// ------------------------------------------------------------
+// ViewCamera: render_views.comp와 1:1 (std430, 32 bytes)
+// ------------------------------------------------------------
+struct ViewCamera {
+    glm::vec2 center;       // 화면 중심이 보는 장면 좌표 (full-res 픽셀)
+    float     zoom;         // 출력 픽셀 / 장면 픽셀
+    float     angle;        // radian
+    uint32_t  width;
+    uint32_t  height;
+    uint32_t  pixelOffset;  // batch 출력 버퍼 안 시작 위치 (픽셀)
+    uint32_t  _pad;
+};
+
+static_assert(sizeof(ViewCamera) == 32, "ViewCamera must be 32 bytes");
+
+struct RenderViewsPC {
+    uint32_t gaussCount;
+    uint32_t viewCount;
+    uint32_t listStride;      // view당 목록 길이 (LOD: lodBudget, 스트리밍: streamBudget, 0 = 전체)
+    uint32_t streamCapacity;  // 스트리밍: slot당 가우시안 수 (0 = 끔)
+    uint32_t compressedChunk; // 압축: chunk당 가우시안 수 (0 = 끔)
+};
+
+struct LodMarkPC {
+    uint32_t nodeCount;
+    uint32_t view;
+    float    lodPixelSize;
+};
+
+struct LodEmitPC {
+    uint32_t nodeCount;
+    uint32_t view;
+    uint32_t budget;
+    uint32_t totalOffset;
+    uint32_t gaussCount;
+};
+
+struct RenderServiceConfig {
+    uint32_t maxViews     = 16;               // batch당 최대 view 수
+    uint32_t maxPixels    = 4096u * 4096u;    // batch당 최대 출력 픽셀 합
+    bool     lod          = false;
+    float    lodPixelSize = 4.0f;             // 노드 투영 크기 ≤ 이 값이면 proxy 1개
+    uint32_t lodBudget    = 1u << 16;         // view당 최대 cut 크기
+    uint32_t lodLeafSize  = 8;
+    std::string       streamPath;             // 비어있지 않으면 스트리밍 모드 (gaussians 무시)
+    ChunkStreamConfig stream;
+    uint32_t          streamBudget = 4096;    // view당 최대 가시 chunk 수
+};
+
+// ------------------------------------------------------------
+// RenderService: pipeline + 상주 버퍼 + timestamp
+// ------------------------------------------------------------
+struct RenderService {
+    ComputeContext      pipeline;
+    BufferBundle        params;
+    BufferBundle        views;
+    BufferBundle        output;
+    BufferBundle        readback;
+    ViewCamera*         mappedViews    = nullptr;
+    const uint8_t*      mappedReadback = nullptr;
+    TimestampPool       timer;
+    uint32_t            gaussCount = 0;
+    RenderServiceConfig cfg;
+
+    // ---------- LOD (cfg.lod일 때만 생성, 아니면 selection/viewCounts는 더미) ----------
+    ComputeContext      lodMark;
+    ComputeContext      lodEmit;
+    ComputeContext      scan;
+    BufferBundle        nodes;
+    BufferBundle        scanData;     // lod_mark 출력 + scan level
+    BufferBundle        selection;    // maxViews × lodBudget
+    BufferBundle        viewCounts;   // HOST_VISIBLE (cut 크기 통계용)
+    uint32_t*           mappedViewCounts = nullptr;
+    ScanPlan            scanPlan;
+    uint32_t            nodeCount = 0;
+
+    // ---------- 스트리밍 (cfg.streamPath일 때만) ----------
+    bool                streaming = false;
+    ChunkResidency      residency;
+    uint32_t*           mappedSelection = nullptr;  // HOST_VISIBLE: view별 가시 chunk 번호
+
+    // ---------- 압축 (params = CompressedGaussian[]) ----------
+    bool                compressed = false;
+    uint32_t            compressedChunk = 0;
+    BufferBundle        codebooks;
+    BufferBundle        packedChunks;
+
+    BufferBundle        dummy;        // 모드별로 안 쓰는 binding 자리 (16 bytes)
+};
+
+// HOST_CACHED가 있으면 CPU 읽기가 빠름 (없으면 coherent만으로)
+inline BufferBundle createReadbackBuffer(
+    VkDevice device,
+    VkPhysicalDevice physicalDevice,
+    VkDeviceSize size
+) {
+    const VkMemoryPropertyFlags coherent =
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    try {
+        return createBuffer(device, physicalDevice, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            coherent | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+    } catch (const std::runtime_error&) {
+        return createBuffer(device, physicalDevice, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, coherent);
+    }
+}
+
+// ------------------------------------------------------------
+// uploadDeviceLocal: staging 경유 DEVICE_LOCAL 버퍼 생성 + 업로드 (1회성)
+// ------------------------------------------------------------
+inline BufferBundle uploadDeviceLocal(
+    const VkEngine& engine,
+    const void* data,
+    VkDeviceSize size,
+    VkBufferUsageFlags usage
+) {
+    VkDevice device = engine.device();
+    BufferBundle dst = createBuffer(device, engine.physicalDevice(), std::max<VkDeviceSize>(size, 16),
+        usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (size == 0) return dst;
+
+    BufferBundle staging = createBuffer(device, engine.physicalDevice(), size,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    uploadToBuffer(device, staging, data, size);
+
+    VkCommandBuffer cmd = engine.commandBuffer();
+    beginOneTimeCommands(cmd);
+    VkBufferCopy region{ 0, 0, size };
+    vkCmdCopyBuffer(cmd, staging.buffer, dst.buffer, 1, &region);
+    vkEndCommandBuffer(cmd);
+    engine.submitAndWait(cmd);
+    vkResetCommandBuffer(cmd, 0);
+    destroyBuffer(device, staging);
+    return dst;
+}
+
+// ------------------------------------------------------------
+// createRenderService: 장면 업로드 (DEVICE_LOCAL 상주) + 버퍼/pipeline 생성
+// ------------------------------------------------------------
+// compressed != nullptr 이면 gaussians 대신 압축 장면 (LOD/스트리밍과 배타)
+// ------------------------------------------------------------
+inline RenderService createRenderService(
+    const VkEngine& engine,
+    const std::string& shaderDir,
+    const std::vector<GaussianParam>& gaussians,
+    const RenderServiceConfig& cfg,
+    const CompressedScene* compressed = nullptr
+) {
+    VkDevice device = engine.device();
+    VkPhysicalDevice physicalDevice = engine.physicalDevice();
+    const VkMemoryPropertyFlags hostMem =
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    RenderService rs;
+    rs.cfg = cfg;
+    rs.gaussCount = uint32_t(gaussians.size());
+    rs.pipeline = createComputePipeline(engine.descriptors(), shaderDir + "render_views.spv", 9, sizeof(RenderViewsPC));
+    rs.streaming  = !cfg.streamPath.empty();
+    rs.compressed = (compressed != nullptr);
+    rs.dummy = createBuffer(device, physicalDevice, 16,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    // ---------- 장면: staging → DEVICE_LOCAL ----------
+    if (rs.compressed) {
+        if (cfg.lod || rs.streaming) throw std::runtime_error("Compressed scenes support the flat path only");
+        rs.gaussCount      = compressed->header.count;
+        rs.compressedChunk = compressed->header.chunkSize;
+        rs.params       = uploadDeviceLocal(engine, compressed->gaussians.data(),
+            compressed->gaussians.size() * sizeof(CompressedGaussian), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+        rs.codebooks    = uploadDeviceLocal(engine, compressed->codebooks.data(),
+            compressed->codebooks.size() * sizeof(glm::vec4), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+        rs.packedChunks = uploadDeviceLocal(engine, compressed->chunks.data(),
+            compressed->chunks.size() * sizeof(CompressedChunk), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+        rs.selection = createBuffer(device, physicalDevice, 16,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    } else if (rs.streaming) {
+        if (cfg.lod) throw std::runtime_error("LOD and streaming modes are exclusive");
+        rs.residency  = createChunkResidency(engine, cfg.streamPath, cfg.stream);
+        rs.gaussCount = rs.residency.file.header.gaussCount;
+        rs.selection  = createBuffer(device, physicalDevice,
+            VkDeviceSize(cfg.maxViews) * cfg.streamBudget * 4, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostMem);
+    } else if (cfg.lod) {
+        LodBuildConfig lodCfg;
+        lodCfg.leafSize = cfg.lodLeafSize;
+        auto t0 = std::chrono::steady_clock::now();
+        LodTree tree = buildLodTree(gaussians, lodCfg);
+        double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        printf("[LOD] %zu nodes (depth %u) for %u gaussians, built in %.1f ms\n",
+            tree.nodes.size(), tree.maxDepth, tree.gaussCount, buildMs);
+
+        rs.gaussCount = tree.gaussCount;
+        rs.nodeCount  = uint32_t(tree.nodes.size());
+        rs.params = uploadDeviceLocal(engine, tree.params.data(),
+            tree.params.size() * sizeof(GaussianParam), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+        rs.nodes  = uploadDeviceLocal(engine, tree.nodes.data(),
+            tree.nodes.size() * sizeof(LodNode), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+
+        rs.scanPlan   = makeScanPlan(rs.nodeCount);
+        rs.scanData   = createBuffer(device, physicalDevice, VkDeviceSize(rs.scanPlan.totalSize) * 4,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        rs.selection  = createBuffer(device, physicalDevice,
+            VkDeviceSize(cfg.maxViews) * cfg.lodBudget * 4,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        rs.lodMark = createComputePipeline(engine.descriptors(), shaderDir + "lod_mark.spv", 3, sizeof(LodMarkPC));
+        rs.lodEmit = createComputePipeline(engine.descriptors(), shaderDir + "lod_emit.spv", 4, sizeof(LodEmitPC));
+        rs.scan    = createScanPipeline(engine.descriptors(), shaderDir);
+    } else {
+        rs.params = uploadDeviceLocal(engine, gaussians.data(),
+            gaussians.size() * sizeof(GaussianParam), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+        rs.selection = createBuffer(device, physicalDevice, 16,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    }
+    rs.viewCounts = createBuffer(device, physicalDevice, std::max(cfg.maxViews, 4u) * sizeof(uint32_t),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostMem);
+
+    // ---------- batch 버퍼 ----------
+    rs.views    = createBuffer(device, physicalDevice, cfg.maxViews * sizeof(ViewCamera),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostMem);
+    rs.output   = createBuffer(device, physicalDevice, VkDeviceSize(cfg.maxPixels) * 4,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    rs.readback = createReadbackBuffer(device, physicalDevice, VkDeviceSize(cfg.maxPixels) * 4);
+
+    // 서비스 수명 동안 map 유지 (매 batch map/unmap 비용 제거)
+    void* mapped = nullptr;
+    vkMapMemory(device, rs.views.memory, 0, rs.views.size, 0, &mapped);
+    rs.mappedViews = static_cast<ViewCamera*>(mapped);
+    vkMapMemory(device, rs.readback.memory, 0, rs.readback.size, 0, &mapped);
+    rs.mappedReadback = static_cast<const uint8_t*>(mapped);
+    vkMapMemory(device, rs.viewCounts.memory, 0, rs.viewCounts.size, 0, &mapped);
+    rs.mappedViewCounts = static_cast<uint32_t*>(mapped);
+    if (rs.streaming) {
+        vkMapMemory(device, rs.selection.memory, 0, rs.selection.size, 0, &mapped);
+        rs.mappedSelection = static_cast<uint32_t*>(mapped);
+    }
+
+    const BufferBundle& params = rs.streaming ? rs.residency.pool : (rs.compressed ? rs.dummy : rs.params);
+    const BufferBundle& table  = rs.streaming ? rs.residency.table : rs.dummy;
+    const BufferBundle& packed = rs.compressed ? rs.params : rs.dummy;
+    const BufferBundle& books  = rs.compressed ? rs.codebooks : rs.dummy;
+    const BufferBundle& chunks = rs.compressed ? rs.packedChunks : rs.dummy;
+    bindSSBO(rs.pipeline, params,        0);
+    bindSSBO(rs.pipeline, rs.views,      1);
+    bindSSBO(rs.pipeline, rs.output,     2);
+    bindSSBO(rs.pipeline, rs.selection,  3);
+    bindSSBO(rs.pipeline, rs.viewCounts, 4);
+    bindSSBO(rs.pipeline, table,         5);
+    bindSSBO(rs.pipeline, packed,        6);
+    bindSSBO(rs.pipeline, books,         7);
+    bindSSBO(rs.pipeline, chunks,        8);
+
+    if (cfg.lod) {
+        bindSSBO(rs.lodMark, rs.nodes,    0);
+        bindSSBO(rs.lodMark, rs.views,    1);
+        bindSSBO(rs.lodMark, rs.scanData, 2);
+
+        bindSSBO(rs.scan, rs.scanData, 0);
+
+        bindSSBO(rs.lodEmit, rs.nodes,      0);
+        bindSSBO(rs.lodEmit, rs.scanData,   1);
+        bindSSBO(rs.lodEmit, rs.selection,  2);
+        bindSSBO(rs.lodEmit, rs.viewCounts, 3);
+    }
+
+    // [0] batch 시작, [1] LOD cut 끝, [2] 렌더 끝, [3] readback copy 끝
+    rs.timer = createTimestampPool(device, physicalDevice, engine.computeQueueFamily(), 4);
+    return rs;
+}
+
+inline void destroyRenderService(VkDevice device, RenderService& rs) {
+    vkUnmapMemory(device, rs.views.memory);
+    vkUnmapMemory(device, rs.readback.memory);
+    vkUnmapMemory(device, rs.viewCounts.memory);
+    if (rs.streaming) {
+        vkUnmapMemory(device, rs.selection.memory);
+        destroyChunkResidency(device, rs.residency);
+    }
+    if (rs.compressed) {
+        destroyBuffer(device, rs.codebooks);
+        destroyBuffer(device, rs.packedChunks);
+    }
+    destroyBuffer(device, rs.dummy);
+    destroyTimestampPool(device, rs.timer);
+    destroyBuffer(device, rs.params);
+    destroyBuffer(device, rs.views);
+    destroyBuffer(device, rs.output);
+    destroyBuffer(device, rs.readback);
+    destroyBuffer(device, rs.selection);
+    destroyBuffer(device, rs.viewCounts);
+    destroyComputePipeline(device, rs.pipeline);
+    if (rs.cfg.lod) {
+        destroyBuffer(device, rs.nodes);
+        destroyBuffer(device, rs.scanData);
+        destroyComputePipeline(device, rs.lodMark);
+        destroyComputePipeline(device, rs.lodEmit);
+        destroyComputePipeline(device, rs.scan);
+    }
+}
+
+// ------------------------------------------------------------
+// BatchTiming: GPU 시간 (timestamp 미지원이면 0)
+// ------------------------------------------------------------
+struct BatchTiming {
+    double lodMs    = 0.0;
+    double renderMs = 0.0;
+    double copyMs   = 0.0;
+    double streamMs = 0.0;           // 스트리밍: 가시성 + 업로드 기록/대기 (host)
+    std::vector<uint32_t> cutSizes;  // LOD 모드: view별 렌더한 가우시안 수
+};
+
+// ------------------------------------------------------------
+// viewBounds: 회전된 화면 사각형 → 장면 좌표 AABB (lod_mark.comp와 동일)
+// ------------------------------------------------------------
+inline void viewBounds(const ViewCamera& cam, glm::vec2& viewMin, glm::vec2& viewMax) {
+    glm::vec2 halfSize = 0.5f * glm::vec2(float(cam.width), float(cam.height)) / cam.zoom;
+    float c = std::abs(std::cos(cam.angle));
+    float s = std::abs(std::sin(cam.angle));
+    glm::vec2 ext(c * halfSize.x + s * halfSize.y, s * halfSize.x + c * halfSize.y);
+    viewMin = cam.center - ext;
+    viewMax = cam.center + ext;
+}
+
+// ------------------------------------------------------------
+// requestStreamViews: view별 가시 chunk 목록 기록 + 상주 요청
+// ------------------------------------------------------------
+// chunk 테이블 선형 탐색 (chunk 수 = 가우시안 수 / chunkSize → 수천 개 수준)
+// 목록은 chunk 번호 순 = Morton 순 → 블렌딩 순서가 view와 무관하게 일정
+// ------------------------------------------------------------
+inline void requestStreamViews(const VkEngine& engine, RenderService& rs, uint32_t viewCount) {
+    ChunkResidency& r = rs.residency;
+    beginStreamBatch(engine.device(), r);
+    for (uint32_t v = 0; v < viewCount; v++) {
+        glm::vec2 viewMin, viewMax;
+        viewBounds(rs.mappedViews[v], viewMin, viewMax);
+        uint32_t* list = rs.mappedSelection + size_t(v) * rs.cfg.streamBudget;
+        uint32_t count = 0;
+        for (uint32_t c = 0; c < r.file.header.chunkCount; c++) {
+            const ChunkInfo& info = r.file.chunks[c];
+            bool visible = info.boundsMin.x <= viewMax.x && info.boundsMin.y <= viewMax.y &&
+                           info.boundsMax.x >= viewMin.x && info.boundsMax.y >= viewMin.y;
+            if (!visible) continue;
+            if (count == rs.cfg.streamBudget) {
+                r.stats.deferred++;
+                continue;
+            }
+            list[count++] = c;
+            requestChunk(engine, r, c);
+        }
+        rs.mappedViewCounts[v] = count;
+    }
+}
+
+// ------------------------------------------------------------
+// renderBatch: views[0..count) 렌더 → readback 포인터에 RGBA8 결과
+// ------------------------------------------------------------
+// 호출 전: rs.mappedViews[i]에 카메라 + pixelOffset 기록 (합계 ≤ maxPixels)
+// 반환 후: rs.mappedReadback + pixelOffset * 4 에서 view별 이미지
+//          (다음 renderBatch 호출 전까지 유효)
+// ------------------------------------------------------------
+inline BatchTiming renderBatch(const VkEngine& engine, RenderService& rs, uint32_t viewCount) {
+    BatchTiming timing;
+    if (viewCount == 0) return timing;
+    if (viewCount > rs.cfg.maxViews) {
+        throw std::runtime_error("renderBatch: viewCount exceeds maxViews");
+    }
+
+    uint32_t maxW = 0, maxH = 0;
+    uint32_t totalPixels = 0;
+    for (uint32_t i = 0; i < viewCount; i++) {
+        maxW = std::max(maxW, rs.mappedViews[i].width);
+        maxH = std::max(maxH, rs.mappedViews[i].height);
+        totalPixels = std::max(totalPixels,
+            rs.mappedViews[i].pixelOffset + rs.mappedViews[i].width * rs.mappedViews[i].height);
+    }
+
+    // ---------- 스트리밍: 가시 chunk 요청 → 업로드 제출 (render가 semaphore 대기) ----------
+    std::vector<VkSemaphore> waits;
+    if (rs.streaming) {
+        auto t0 = std::chrono::steady_clock::now();
+        requestStreamViews(engine, rs, viewCount);
+        waits = endStreamRequests(engine, rs.residency);
+        timing.streamMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+    VkCommandBuffer cmd = engine.commandBuffer();
+    beginOneTimeCommands(cmd);
+    recordTimestampReset(cmd, rs.timer);
+    recordTimestamp(cmd, rs.timer, 0);
+
+    // ---------- LOD cut: view마다 mark → scan → emit (scanData 재사용) ----------
+    if (rs.cfg.lod) {
+        const uint32_t nodeGroups = std::min(65535u, std::max(1u, (rs.nodeCount + 255) / 256));
+        for (uint32_t v = 0; v < viewCount; v++) {
+            LodMarkPC markPC{ rs.nodeCount, v, rs.cfg.lodPixelSize };
+            recordDispatch(cmd, rs.lodMark, &markPC, sizeof(markPC), nodeGroups);
+            recordComputeBarrier(cmd);
+            recordExclusiveScan(cmd, rs.scan, rs.scanPlan);
+            LodEmitPC emitPC{ rs.nodeCount, v, rs.cfg.lodBudget, rs.scanPlan.totalOffset, rs.gaussCount };
+            recordDispatch(cmd, rs.lodEmit, &emitPC, sizeof(emitPC), nodeGroups);
+            recordComputeBarrier(cmd);  // 다음 view mark가 scanData 덮어쓰기 전 / render 읽기 전
+        }
+    }
+    recordTimestamp(cmd, rs.timer, 1);
+
+    RenderViewsPC pc{ rs.gaussCount, viewCount, 0u, 0u, rs.compressedChunk };
+    if (rs.streaming) {
+        pc.listStride     = rs.cfg.streamBudget;
+        pc.streamCapacity = rs.residency.slotCapacity;
+    } else if (rs.cfg.lod) {
+        pc.listStride = rs.cfg.lodBudget;
+    }
+    recordDispatch(cmd, rs.pipeline, &pc, sizeof(pc), (maxW + 7) / 8, (maxH + 7) / 8, viewCount);
+    recordTimestamp(cmd, rs.timer, 2);
+
+    // compute write → transfer read
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    VkBufferCopy region{ 0, 0, VkDeviceSize(totalPixels) * 4 };
+    vkCmdCopyBuffer(cmd, rs.output.buffer, rs.readback.buffer, 1, &region);
+
+    // transfer write (이미지) + shader write (viewCounts) → host read (map 포인터로 바로 읽음)
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+    recordTimestamp(cmd, rs.timer, 3);
+    vkEndCommandBuffer(cmd);
+
+    if (waits.empty()) {
+        engine.submitAndWait(cmd);
+    } else {
+        engine.submitAndWait(cmd, waits);
+    }
+    vkResetCommandBuffer(cmd, 0);
+    if (rs.streaming) finishStreamBatch(rs.residency);
+
+    std::vector<double> ts;
+    if (readTimestampsMs(engine.device(), rs.timer, ts)) {
+        timing.lodMs    = ts[1] - ts[0];
+        timing.renderMs = ts[2] - ts[1];
+        timing.copyMs   = ts[3] - ts[2];
+    }
+    if (rs.cfg.lod) {
+        timing.cutSizes.assign(rs.mappedViewCounts, rs.mappedViewCounts + viewCount);
+    }
+    return timing;
+}
+
+} // namespace gs
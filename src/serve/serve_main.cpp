@@ -0,0 +1,570 @@
+// ============================================================
+// File: src/serve/serve_main.cpp
+// Role: 오프스크린 렌더 서비스 (stdin 카메라 요청 → batch 렌더 → stdout 이미지)
+// ============================================================
+//
+// 학습된 장면(.gsplat)을 GPU에 상주시키고, stdin으로 들어오는 카메라 요청을
+// 모아서 dispatch 1번에 렌더 → pinned readback → stdout(또는 파일)으로 전송
+//
+// 요청 (stdin, 한 줄에 하나):
+//   view <id> <width> <height> <centerX> <centerY> [zoom] [angleDeg]
+//   flush        대기 중인 요청 즉시 렌더 (빈 줄도 동일)
+//   stats        지금까지 통계 출력 (stderr)
+//   quit         남은 요청 처리 후 종료 (EOF도 동일)
+//
+// 응답 (stdout, 요청 순서대로):
+//   frame <id> <ppm|raw> <width> <height> <bytes>\n  + 이미지 bytes
+//     ppm = P6 헤더 포함 RGB, raw = RGBA8 (width × height × 4)
+//   saved <id> <path>\n        (--out-dir 사용 시)
+//   error <id> <message>\n
+//
+// stdout은 데이터 전용: 엔진/진단 로그(printf)는 stderr로 돌림
+//
+// batch 조건: 대기 요청이 --batch 개 또는 출력 픽셀이 --max-pixels 도달,
+//             가장 오래된 대기 요청이 --max-wait-ms 경과 (기본 10, 0 = 끔),
+//             혹은 flush / EOF
+//   → flush를 보내지 않는 클라이언트도 요청 1개가 최대 max-wait-ms만 대기
+//     (latency 통계 = 실제 서비스 기준: batch 대기 + 렌더 + 전송)
+//
+// 실행 예시 (build 폴더 기준):
+//   gaussian_serve --scene ../ppmOutput/scene.gsplat --batch 8 < cams.txt > frames.bin
+//   gaussian_serve --synthetic 100000 --extent 1024 --out-dir frames --format ppm
+//   gaussian_serve --synthetic 2e7 --extent 65536 --lod --lod-pixel-size 4   (대형 장면)
+//   gaussian_serve --stream big.gschunk --stream-pool-mb 512 --stream-async  (GPU 메모리보다 큰 장면)
+//   gaussian_serve --compressed scene.gscomp   (codebook 압축 장면, shader 디코드)
+// ============================================================
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <unistd.h>
+#include <poll.h>
+#include <cerrno>
+#endif
+
+#include "common/GaussianTypes.hpp"
+#include "common/SceneGen.hpp"
+#include "common/SceneIO.hpp"
+#include "engine/VkEngine.hpp"
+#include "serve/RenderService.hpp"
+#include "utils/ImageIO.hpp"
+
+namespace {
+
+// ------------------------------------------------------------
+// 서비스 설정 (CLI)
+// ------------------------------------------------------------
+struct ServeConfig {
+    std::string scenePath;                 // 비어있으면 합성 장면
+    uint32_t    syntheticCount = 10000;
+    uint32_t    extent         = 512;      // 합성 장면 좌표 범위 (정사각형)
+    uint32_t    batch          = 16;
+    uint32_t    maxPixels      = 4096u * 4096u;
+    double      maxWaitMs      = 10.0;     // 가장 오래된 대기 요청 기준, 0 = flush/가득 찰 때만
+    bool        rawFormat      = false;    // false = ppm
+    std::string outDir;                    // 비어있으면 stdout 스트림
+    std::string device;
+    bool        pushDescriptors = true;    // false = 공유 descriptor pool fallback
+    std::string shaderDir      = "../src/shaders/";
+    bool        lod            = false;
+    float       lodPixelSize   = 4.0f;
+    uint32_t    lodBudget      = 1u << 16;
+    uint32_t    lodLeafSize    = 8;
+    std::string streamPath;                // .gschunk (gaussian_chunk로 생성)
+    uint32_t    streamPoolMB   = 256;
+    uint32_t    streamBudget   = 4096;
+    uint32_t    streamUpload   = 32;
+    bool        streamAsync    = false;
+    std::string compressedPath;            // .gscomp (gaussian_compress로 생성)
+};
+
+void printUsage() {
+    fprintf(stderr,
+        "Usage: gaussian_serve [options] < requests\n"
+        "  --scene FILE          .gsplat scene (default: synthetic)\n"
+        "  --synthetic N         synthetic scene size (default 10000)\n"
+        "  --extent PX           synthetic scene extent (default 512)\n"
+        "  --batch N             max views per dispatch (default 16)\n"
+        "  --max-pixels N        max output pixels per batch (default 4096*4096)\n"
+        "  --max-wait-ms MS      render a partial batch once its oldest request waited MS (default 10, 0 = off)\n"
+        "  --format ppm|raw      response payload (default ppm)\n"
+        "  --out-dir DIR         write <id>.ppm/.raw files instead of streaming\n"
+        "  --device NAME         device name substring (e.g. llvmpipe)\n"
+        "  --pool-descriptors    use the shared descriptor pool even if push descriptors exist\n"
+        "  --shaders DIR         SPIR-V directory (default ../src/shaders/)\n"
+        "  --lod                 hierarchical LOD cut per view\n"
+        "  --lod-pixel-size F    node projected size accepted as one proxy (default 4)\n"
+        "  --lod-budget N        max gaussians per view cut (default 65536)\n"
+        "  --lod-leaf N          gaussians per leaf node (default 8)\n"
+        "  --stream FILE         out-of-core .gschunk scene (chunks paged into a GPU pool)\n"
+        "  --stream-pool-mb N    GPU chunk pool size (default 256)\n"
+        "  --stream-budget N     max visible chunks per view (default 4096)\n"
+        "  --stream-upload N     chunks per transfer submit (default 32)\n"
+        "  --stream-async        render resident chunks only, upload misses in background\n"
+        "  --compressed FILE     codebook-compressed .gscomp scene (decoded in-shader)\n");
+}
+
+ServeConfig parseArgs(int argc, char** argv) {
+    ServeConfig cfg;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        auto next = [&]() -> const char* {
+            if (i + 1 >= argc) throw std::runtime_error("Missing value for " + a);
+            return argv[++i];
+        };
+        if      (a == "--scene")      cfg.scenePath = next();
+        else if (a == "--synthetic")  cfg.syntheticCount = uint32_t(std::strtod(next(), nullptr));
+        else if (a == "--extent")     cfg.extent = uint32_t(std::max(1, std::atoi(next())));
+        else if (a == "--batch")      cfg.batch = uint32_t(std::max(1, std::atoi(next())));
+        else if (a == "--max-pixels") cfg.maxPixels = uint32_t(std::strtod(next(), nullptr));
+        else if (a == "--max-wait-ms") cfg.maxWaitMs = std::max(0.0, std::strtod(next(), nullptr));
+        else if (a == "--format") {
+            std::string f = next();
+            if (f != "ppm" && f != "raw") throw std::runtime_error("Unknown format: " + f);
+            cfg.rawFormat = (f == "raw");
+        }
+        else if (a == "--out-dir")    cfg.outDir = next();
+        else if (a == "--device")     cfg.device = next();
+        else if (a == "--pool-descriptors") cfg.pushDescriptors = false;
+        else if (a == "--shaders")    cfg.shaderDir = next();
+        else if (a == "--lod")        cfg.lod = true;
+        else if (a == "--lod-pixel-size") cfg.lodPixelSize = float(std::atof(next()));
+        else if (a == "--lod-budget") cfg.lodBudget = uint32_t(std::max(1.0, std::strtod(next(), nullptr)));
+        else if (a == "--lod-leaf")   cfg.lodLeafSize = uint32_t(std::max(1, std::atoi(next())));
+        else if (a == "--stream")     cfg.streamPath = next();
+        else if (a == "--stream-pool-mb") cfg.streamPoolMB = uint32_t(std::max(1, std::atoi(next())));
+        else if (a == "--stream-budget")  cfg.streamBudget = uint32_t(std::max(1, std::atoi(next())));
+        else if (a == "--stream-upload")  cfg.streamUpload = uint32_t(std::max(1, std::atoi(next())));
+        else if (a == "--stream-async")   cfg.streamAsync = true;
+        else if (a == "--compressed") cfg.compressedPath = next();
+        else if (a == "--help" || a == "-h") { printUsage(); std::exit(0); }
+        else throw std::runtime_error("Unknown option: " + a);
+    }
+    if (cfg.lod && !cfg.streamPath.empty()) {
+        throw std::runtime_error("--lod and --stream cannot be combined");
+    }
+    if (!cfg.compressedPath.empty() && (cfg.lod || !cfg.streamPath.empty())) {
+        throw std::runtime_error("--compressed cannot be combined with --lod or --stream");
+    }
+    return cfg;
+}
+
+double nowMs() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+// ------------------------------------------------------------
+// stdout 분리: 데이터 채널 = 원래 stdout, printf = stderr
+// ------------------------------------------------------------
+// VkEngine 등 기존 코드의 printf 로그가 이미지 스트림에 섞이지 않도록
+// ------------------------------------------------------------
+FILE* detachDataStream() {
+    fflush(stdout);
+#ifdef _WIN32
+    int dataFd = _dup(_fileno(stdout));
+    _setmode(dataFd, _O_BINARY);
+    _dup2(_fileno(stderr), _fileno(stdout));
+    return _fdopen(dataFd, "wb");
+#else
+    int dataFd = dup(fileno(stdout));
+    dup2(fileno(stderr), fileno(stdout));
+    return fdopen(dataFd, "wb");
+#endif
+}
+
+// ------------------------------------------------------------
+// 요청 줄 읽기 (timeout 지원)
+// ------------------------------------------------------------
+// std::getline(std::cin)은 자체 버퍼에 미리 읽어두므로 poll과 같이 쓸 수 없음
+//   → fd 0을 직접 read, 줄 단위로 잘라 반환
+// timeoutMs < 0 = 무한 대기
+// Windows: 파이프 poll 없음 → blocking getline (max-wait는 다음 줄 도착 시 확인)
+// ------------------------------------------------------------
+enum class ReadResult { Line, Timeout, Eof };
+
+struct LineReader {
+    std::string buffer;
+    bool        eof = false;
+
+    ReadResult next(std::string& line, int timeoutMs) {
+#ifdef _WIN32
+        (void)timeoutMs;
+        return std::getline(std::cin, line) ? ReadResult::Line : ReadResult::Eof;
+#else
+        while (true) {
+            size_t nl = buffer.find('\n');
+            if (nl != std::string::npos) {
+                line.assign(buffer, 0, nl);
+                buffer.erase(0, nl + 1);
+                return ReadResult::Line;
+            }
+            if (eof) {
+                if (buffer.empty()) return ReadResult::Eof;
+                line.swap(buffer);  // 개행 없는 마지막 줄
+                buffer.clear();
+                return ReadResult::Line;
+            }
+            pollfd pfd{ STDIN_FILENO, POLLIN, 0 };
+            int ready = poll(&pfd, 1, timeoutMs);
+            if (ready < 0 && errno == EINTR) continue;
+            if (ready == 0) return ReadResult::Timeout;
+
+            char chunk[4096];
+            ssize_t n = (ready > 0) ? read(STDIN_FILENO, chunk, sizeof(chunk)) : -1;
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) eof = true;
+            else buffer.append(chunk, size_t(n));
+        }
+#endif
+    }
+};
+
+// ------------------------------------------------------------
+// 요청 1개 (도착 시각 포함)
+// ------------------------------------------------------------
+struct Request {
+    std::string    id;
+    gs::ViewCamera cam{};
+    double         arrivedMs = 0.0;
+};
+
+// ------------------------------------------------------------
+// 통계: 요청별 latency (도착 → 응답 기록 완료) + batch별 GPU 시간
+// ------------------------------------------------------------
+struct ServeStats {
+    std::vector<double> latencyMs;
+    std::vector<double> queueMs;     // 도착 → batch 제출
+    std::vector<double> gpuMs;       // batch별 render + copy (timestamp)
+    std::vector<double> lodMs;       // batch별 LOD cut 선택 (timestamp, --lod)
+    std::vector<double> cutSizes;    // view별 렌더한 가우시안 수 (--lod)
+    std::vector<double> batchMs;     // batch별 wall (제출 → 전체 응답 기록)
+    std::vector<double> streamMs;    // batch별 chunk 요청 + 업로드 (host, --stream)
+    uint32_t batches   = 0;
+    uint32_t frames    = 0;
+    uint32_t errors    = 0;
+    double   pixels    = 0.0;
+    double   firstMs   = 0.0;        // 첫 요청 도착
+    double   lastMs    = 0.0;        // 마지막 응답
+};
+
+double percentile(std::vector<double> v, double p) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    size_t idx = size_t(std::ceil(p / 100.0 * double(v.size())));
+    return v[std::min(v.size() - 1, idx > 0 ? idx - 1 : 0)];
+}
+
+double mean(const std::vector<double>& v) {
+    if (v.empty()) return 0.0;
+    double sum = 0;
+    for (double x : v) sum += x;
+    return sum / double(v.size());
+}
+
+void printStats(const ServeStats& s, const gs::RenderService& rs) {
+    double wallS = std::max(1e-9, (s.lastMs - s.firstMs) / 1e3);
+    fprintf(stderr, "\n=== Render Service Stats ===\n");
+    fprintf(stderr, "  frames %u, batches %u (avg %.2f views/batch), errors %u\n",
+        s.frames, s.batches, s.batches ? double(s.frames) / s.batches : 0.0, s.errors);
+    fprintf(stderr, "  latency ms : mean %.3f | p50 %.3f | p95 %.3f | p99 %.3f | max %.3f\n",
+        mean(s.latencyMs), percentile(s.latencyMs, 50), percentile(s.latencyMs, 95),
+        percentile(s.latencyMs, 99), percentile(s.latencyMs, 100));
+    fprintf(stderr, "  queue ms   : mean %.3f | p95 %.3f\n",
+        mean(s.queueMs), percentile(s.queueMs, 95));
+    fprintf(stderr, "  batch ms   : mean %.3f (gpu render+copy %.3f)\n",
+        mean(s.batchMs), mean(s.gpuMs));
+    if (!s.cutSizes.empty()) {
+        fprintf(stderr, "  lod        : cut mean %.0f | p95 %.0f | max %.0f gaussians, select %.3f ms/batch\n",
+            mean(s.cutSizes), percentile(s.cutSizes, 95), percentile(s.cutSizes, 100), mean(s.lodMs));
+    }
+    if (rs.streaming) {
+        const gs::ChunkStreamStats& st = rs.residency.stats;
+        double requests = double(std::max<uint64_t>(1, st.requests));
+        fprintf(stderr, "  stream     : %llu requests | hit %.1f%% | miss %llu | pending %llu | deferred %llu | evict %llu\n",
+            (unsigned long long)st.requests, 100.0 * double(st.hits) / requests,
+            (unsigned long long)st.misses, (unsigned long long)st.pending,
+            (unsigned long long)st.deferred, (unsigned long long)st.evictions);
+        fprintf(stderr, "               uploaded %.1f MB in %llu submits, %.2f GB/s (transfer %.3f ms, staging %.3f ms), "
+            "resident %u/%u slots, %.3f ms/batch\n",
+            double(st.bytesUploaded) / (1024.0 * 1024.0), (unsigned long long)st.submits,
+            st.transferMs > 0.0 ? double(st.bytesUploaded) / (st.transferMs * 1e6) : 0.0,
+            st.transferMs, st.stageMs, gs::residentChunkCount(rs.residency), rs.residency.slotCount,
+            mean(s.streamMs));
+    }
+    fprintf(stderr, "  throughput : %.2f frames/s, %.2f Mpix/s (wall %.3f s)\n",
+        s.frames / wallS, s.pixels / 1e6 / wallS, wallS);
+}
+
+// ------------------------------------------------------------
+// 응답 기록
+// ------------------------------------------------------------
+bool writeFrame(const ServeConfig& cfg, FILE* data, const Request& r, const uint8_t* rgba) {
+    const uint32_t w = r.cam.width, h = r.cam.height;
+    const char* fmt = cfg.rawFormat ? "raw" : "ppm";
+
+    std::ostringstream payload;
+    if (cfg.rawFormat) {
+        payload.write(reinterpret_cast<const char*>(rgba), std::streamsize(size_t(w) * h * 4));
+    } else {
+        gs::writePPMRGBA8(payload, rgba, w, h);
+    }
+    const std::string bytes = payload.str();
+
+    if (!cfg.outDir.empty()) {
+        std::string path = cfg.outDir + "/" + r.id + "." + fmt;
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            fprintf(data, "error %s cannot open %s\n", r.id.c_str(), path.c_str());
+            return false;
+        }
+        file.write(bytes.data(), std::streamsize(bytes.size()));
+        fprintf(data, "saved %s %s\n", r.id.c_str(), path.c_str());
+        return true;
+    }
+
+    fprintf(data, "frame %s %s %u %u %zu\n", r.id.c_str(), fmt, w, h, bytes.size());
+    fwrite(bytes.data(), 1, bytes.size(), data);
+    return true;
+}
+
+// ------------------------------------------------------------
+// flushBatch: 대기 요청 → batch 단위로 렌더 + 응답
+// ------------------------------------------------------------
+void flushBatch(
+    const ServeConfig& cfg,
+    gs::VkEngine& engine,
+    gs::RenderService& rs,
+    FILE* data,
+    std::vector<Request>& pending,
+    ServeStats& stats
+) {
+    size_t begin = 0;
+    while (begin < pending.size()) {
+        // ---------- batch 구성 (view 수 / 픽셀 합 상한) ----------
+        uint32_t count = 0;
+        uint32_t offset = 0;
+        while (begin + count < pending.size() && count < cfg.batch) {
+            gs::ViewCamera cam = pending[begin + count].cam;
+            uint32_t px = cam.width * cam.height;
+            if (count > 0 && offset + px > cfg.maxPixels) break;
+            cam.pixelOffset = offset;
+            rs.mappedViews[count] = cam;
+            pending[begin + count].cam.pixelOffset = offset;
+            offset += px;
+            count++;
+        }
+
+        double submitMs = nowMs();
+        gs::BatchTiming timing = gs::renderBatch(engine, rs, count);
+
+        for (uint32_t i = 0; i < count; i++) {
+            const Request& r = pending[begin + i];
+            const uint8_t* rgba = rs.mappedReadback + size_t(r.cam.pixelOffset) * 4;
+            if (writeFrame(cfg, data, r, rgba)) {
+                stats.frames++;
+                stats.pixels += double(r.cam.width) * r.cam.height;
+            } else {
+                stats.errors++;
+            }
+            fflush(data);
+            double doneMs = nowMs();
+            stats.latencyMs.push_back(doneMs - r.arrivedMs);
+            stats.queueMs.push_back(submitMs - r.arrivedMs);
+            stats.lastMs = doneMs;
+        }
+        stats.batchMs.push_back(nowMs() - submitMs);
+        stats.gpuMs.push_back(timing.renderMs + timing.copyMs);
+        if (cfg.lod) {
+            stats.lodMs.push_back(timing.lodMs);
+            for (uint32_t c : timing.cutSizes) stats.cutSizes.push_back(double(c));
+        }
+        if (rs.streaming) stats.streamMs.push_back(timing.streamMs);
+        stats.batches++;
+        begin += count;
+    }
+    pending.clear();
+}
+
+// ------------------------------------------------------------
+// parseView: "view <id> <w> <h> <cx> <cy> [zoom] [angleDeg]"
+// ------------------------------------------------------------
+bool parseView(std::istringstream& in, const ServeConfig& cfg, Request& r, std::string& err) {
+    long long w = 0, h = 0;
+    float cx = 0, cy = 0, zoom = 1.0f, angleDeg = 0.0f;
+    if (!(in >> r.id >> w >> h >> cx >> cy)) {
+        err = "expected: view <id> <width> <height> <centerX> <centerY> [zoom] [angleDeg]";
+        return false;
+    }
+    in >> zoom;
+    in >> angleDeg;
+    if (w <= 0 || h <= 0 || w * h > (long long)cfg.maxPixels) {
+        err = "size out of range (max-pixels " + std::to_string(cfg.maxPixels) + ")";
+        return false;
+    }
+    if (!(zoom > 0.0f)) {
+        err = "zoom must be positive";
+        return false;
+    }
+    r.cam.center = glm::vec2(cx, cy);
+    r.cam.zoom   = zoom;
+    r.cam.angle  = angleDeg * 3.14159265f / 180.0f;
+    r.cam.width  = uint32_t(w);
+    r.cam.height = uint32_t(h);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ServeConfig cfg;
+    try {
+        cfg = parseArgs(argc, argv);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "[Error] %s\n", e.what());
+        printUsage();
+        return 1;
+    }
+
+    FILE* data = detachDataStream();
+    if (!data) {
+        fprintf(stderr, "[Error] Cannot open data stream\n");
+        return 1;
+    }
+
+    // ============================================================
+    // 장면 로드
+    // ============================================================
+    gs::Scene scene;
+    gs::CompressedScene compressed;
+    if (!cfg.streamPath.empty()) {
+        // 스트리밍: 장면은 RenderService가 파일에서 chunk 단위로 직접 읽음
+    } else if (!cfg.compressedPath.empty()) {
+        if (!gs::loadCompressedScene(cfg.compressedPath, compressed)) return 1;
+        printf("[Serve] Compressed scene: %u gaussians, extent %ux%u\n",
+            compressed.header.count, compressed.header.width, compressed.header.height);
+    } else if (!cfg.scenePath.empty()) {
+        if (!gs::loadScene(cfg.scenePath, scene)) return 1;
+    } else {
+        gs::SceneGenConfig gen;
+        gen.count = cfg.syntheticCount;
+        gen.width = gen.height = cfg.extent;
+        scene.gaussians = gs::generateScene(gen);
+        scene.width = scene.height = cfg.extent;
+    }
+    if (cfg.streamPath.empty() && cfg.compressedPath.empty()) {
+        printf("[Serve] Scene: %zu gaussians, extent %ux%u\n",
+            scene.gaussians.size(), scene.width, scene.height);
+    }
+
+    gs::VkEngine engine;
+    gs::RenderService rs;
+    try {
+        engine.init(nullptr, cfg.device.empty() ? nullptr : cfg.device.c_str(), cfg.pushDescriptors);
+        gs::RenderServiceConfig rsCfg;
+        rsCfg.maxViews  = cfg.batch;
+        rsCfg.maxPixels = cfg.maxPixels;
+        rsCfg.lod          = cfg.lod;
+        rsCfg.lodPixelSize = cfg.lodPixelSize;
+        rsCfg.lodBudget    = cfg.lodBudget;
+        rsCfg.lodLeafSize  = cfg.lodLeafSize;
+        rsCfg.streamPath          = cfg.streamPath;
+        rsCfg.stream.poolBytes    = uint64_t(cfg.streamPoolMB) << 20;
+        rsCfg.stream.uploadChunks = cfg.streamUpload;
+        rsCfg.stream.async        = cfg.streamAsync;
+        rsCfg.streamBudget        = cfg.streamBudget;
+        rs = gs::createRenderService(engine, cfg.shaderDir, scene.gaussians, rsCfg,
+            cfg.compressedPath.empty() ? nullptr : &compressed);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "[Error] %s\n", e.what());
+        return 1;
+    }
+    printf("[Serve] Ready on %s (batch %u, max %u px)\n",
+        engine.deviceName().c_str(), cfg.batch, cfg.maxPixels);
+
+    // ============================================================
+    // 요청 루프
+    // ============================================================
+    ServeStats stats;
+    std::vector<Request> pending;
+    uint32_t pendingPixels = 0;
+    LineReader reader;
+    std::string line;
+    while (true) {
+        // ---------- 대기 시간 상한: 가장 오래된 요청 기준 ----------
+        int timeoutMs = -1;
+        if (!pending.empty() && cfg.maxWaitMs > 0.0) {
+            double left = pending.front().arrivedMs + cfg.maxWaitMs - nowMs();
+            if (left <= 0.0) {
+                flushBatch(cfg, engine, rs, data, pending, stats);
+                pendingPixels = 0;
+            } else {
+                timeoutMs = int(std::ceil(left));
+            }
+        }
+
+        ReadResult rr = reader.next(line, timeoutMs);
+        if (rr == ReadResult::Eof) break;
+        if (rr == ReadResult::Timeout) continue;  // 위에서 flush
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        std::istringstream in(line);
+        std::string cmdName;
+        in >> cmdName;
+
+        if (cmdName.empty() || cmdName == "flush") {
+            flushBatch(cfg, engine, rs, data, pending, stats);
+            pendingPixels = 0;
+        } else if (cmdName == "stats") {
+            printStats(stats, rs);
+        } else if (cmdName == "quit") {
+            break;
+        } else if (cmdName == "view") {
+            Request r;
+            r.arrivedMs = nowMs();
+            if (stats.firstMs == 0.0) stats.firstMs = r.arrivedMs;
+            std::string err;
+            if (!parseView(in, cfg, r, err)) {
+                fprintf(data, "error %s %s\n", r.id.empty() ? "-" : r.id.c_str(), err.c_str());
+                fflush(data);
+                stats.errors++;
+                continue;
+            }
+            uint32_t px = r.cam.width * r.cam.height;
+            if (!pending.empty() && pendingPixels + px > cfg.maxPixels) {
+                flushBatch(cfg, engine, rs, data, pending, stats);
+                pendingPixels = 0;
+            }
+            pending.push_back(r);
+            pendingPixels += px;
+            if (pending.size() >= cfg.batch) {
+                flushBatch(cfg, engine, rs, data, pending, stats);
+                pendingPixels = 0;
+            }
+        } else {
+            fprintf(data, "error - unknown command %s\n", cmdName.c_str());
+            fflush(data);
+            stats.errors++;
+        }
+    }
+    flushBatch(cfg, engine, rs, data, pending, stats);
+
+    printStats(stats, rs);
+
+    fclose(data);
+    gs::destroyRenderService(engine.device(), rs);
+    engine.cleanup();
+    return 0;
+}
@@ -18,6 +18,17 @@ glslc simple.comp -o simple.spv
 glslc gaussian.comp -o gaussian.spv
 glslc backward.comp -o backward.spv
 glslc loss.comp -o loss.spv
+glslc downsample.comp -o downsample.spv
+glslc sample_tiles.comp -o sample_tiles.spv
+glslc render_views.comp -o render_views.spv
+glslc scan.comp -o scan.spv
+glslc lod_mark.comp -o lod_mark.spv
+glslc lod_emit.comp -o lod_emit.spv
+glslc backward_tiles.comp -o backward_tiles.spv
+glslc grad_reduce.comp -o grad_reduce.spv
+glslc gaussian_oit.comp -o gaussian_oit.spv
+glslc backward_oit.comp -o backward_oit.spv
+glslc train_fused.comp -o train_fused.spv
 
 if %errorlevel% neq 0 (
     echo [ERROR] Shader compilation failed!
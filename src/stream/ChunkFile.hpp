@@ -0,0 +1,188 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include "common/GaussianTypes.hpp"
+#include "common/SceneIO.hpp"
+#include "lod/LodTree.hpp"
+#include "stream/MappedFile.hpp"
+// ============================================================
+// 파일: src/stream/ChunkFile.hpp
+// 역할: out-of-core 장면 파일 (.gschunk) - 공간 chunk 단위 저장/매핑
+// ============================================================
+//
+// 레이아웃 (little-endian):
+//   ChunkFileHeader (32 bytes)
+//   ChunkInfo[chunkCount] (32 bytes each)
+//   [CHUNK_DATA_ALIGN 정렬] chunk 0 GaussianParam[count], chunk 1 ...
+//
+// chunk = Morton 순으로 정렬한 가우시안의 연속 chunkSize개
+//   → 같은 chunk는 공간적으로 뭉쳐 있음 (quadtree 셀 조각)
+//   → bounds = 3σ 원을 모두 포함하는 AABB (view 가시성 판정용)
+// chunk 데이터는 페이지 경계 정렬 → mmap 페이지 하나가 chunk 둘에 걸치지 않음
+//
+// 블렌딩 순서 = chunk 번호 순 → chunk 안 순서 (LodTree와 같은 Morton 순)
+// ============================================================
+
+namespace gs {
+
+const uint32_t CHUNK_FILE_MAGIC   = 0x4B435347;  // "GSCK"
+const uint32_t CHUNK_FILE_VERSION = 1;
+const uint64_t CHUNK_DATA_ALIGN   = 4096;
+
+struct ChunkFileHeader {
+    uint32_t magic      = CHUNK_FILE_MAGIC;
+    uint32_t version    = CHUNK_FILE_VERSION;
+    uint32_t chunkCount = 0;
+    uint32_t chunkSize  = 0;   // chunk당 최대 가우시안 수 (= GPU pool slot 크기)
+    uint32_t gaussCount = 0;
+    uint32_t width      = 0;   // 장면 좌표 범위 (SceneFileHeader와 동일 의미)
+    uint32_t height     = 0;
+    uint32_t _pad       = 0;
+};
+
+static_assert(sizeof(ChunkFileHeader) == 32, "ChunkFileHeader must be 32 bytes");
+
+struct ChunkInfo {
+    glm::vec2 boundsMin;
+    glm::vec2 boundsMax;
+    uint32_t  count;       // 이 chunk 가우시안 수 (≤ chunkSize)
+    uint32_t  _pad;
+    uint64_t  fileOffset;  // 파일 시작 기준 byte 위치
+};
+
+static_assert(sizeof(ChunkInfo) == 32, "ChunkInfo must be 32 bytes");
+
+// ------------------------------------------------------------
+// writeChunkFile: Scene → Morton 정렬 → chunk 분할 → .gschunk
+// ------------------------------------------------------------
+inline bool writeChunkFile(const std::string& filename, const Scene& scene, uint32_t chunkSize) {
+    if (chunkSize == 0) {
+        printf("[Error] chunkSize must be positive\n");
+        return false;
+    }
+    const uint32_t N = uint32_t(scene.gaussians.size());
+
+    // ---------- Morton 정렬 (LodTree와 같은 16-bit 양자화) ----------
+    const std::vector<uint32_t> order = mortonOrder(scene.gaussians);
+
+    // ---------- chunk 테이블 ----------
+    ChunkFileHeader header;
+    header.chunkCount = (N + chunkSize - 1) / chunkSize;
+    header.chunkSize  = chunkSize;
+    header.gaussCount = N;
+    header.width      = scene.width;
+    header.height     = scene.height;
+
+    auto alignUp = [](uint64_t v) { return (v + CHUNK_DATA_ALIGN - 1) / CHUNK_DATA_ALIGN * CHUNK_DATA_ALIGN; };
+    std::vector<ChunkInfo> chunks(header.chunkCount);
+    uint64_t offset = alignUp(sizeof(ChunkFileHeader) + chunks.size() * sizeof(ChunkInfo));
+    for (uint32_t c = 0; c < header.chunkCount; c++) {
+        ChunkInfo& info = chunks[c];
+        info.boundsMin  = glm::vec2(1e30f);
+        info.boundsMax  = glm::vec2(-1e30f);
+        info.count      = std::min(chunkSize, N - c * chunkSize);
+        info._pad       = 0;
+        info.fileOffset = offset;
+        for (uint32_t k = 0; k < info.count; k++) {
+            const GaussianParam& g = scene.gaussians[order[size_t(c) * chunkSize + k]];
+            glm::vec2 center(g.position.x, g.position.y);
+            float r = 3.0f * g.scale.x;
+            info.boundsMin = glm::min(info.boundsMin, center - r);
+            info.boundsMax = glm::max(info.boundsMax, center + r);
+        }
+        offset = alignUp(offset + uint64_t(info.count) * sizeof(GaussianParam));
+    }
+
+    // ---------- 기록 ----------
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        printf("[Error] Cannot open %s\n", filename.c_str());
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(chunks.data()),
+        std::streamsize(chunks.size() * sizeof(ChunkInfo)));
+
+    std::vector<GaussianParam> buffer(chunkSize);
+    const char zeros[CHUNK_DATA_ALIGN] = {};
+    for (uint32_t c = 0; c < header.chunkCount; c++) {
+        uint64_t pos = uint64_t(file.tellp());
+        file.write(zeros, std::streamsize(chunks[c].fileOffset - pos));
+        for (uint32_t k = 0; k < chunks[c].count; k++) {
+            buffer[k] = scene.gaussians[order[size_t(c) * chunkSize + k]];
+        }
+        file.write(reinterpret_cast<const char*>(buffer.data()),
+            std::streamsize(chunks[c].count * sizeof(GaussianParam)));
+    }
+
+    if (!file.good()) {
+        printf("[Error] Write failed: %s\n", filename.c_str());
+        return false;
+    }
+    printf("[OK] Saved %s (%u gaussians in %u chunks of %u, %.1f MB)\n",
+        filename.c_str(), N, header.chunkCount, chunkSize, double(file.tellp()) / (1024.0 * 1024.0));
+    return true;
+}
+
+// ------------------------------------------------------------
+// ChunkFile: 매핑된 .gschunk (헤더/테이블/데이터 모두 mmap 포인터)
+// ------------------------------------------------------------
+struct ChunkFile {
+    MappedFile       mapped;
+    ChunkFileHeader  header;
+    const ChunkInfo* chunks = nullptr;
+
+    const GaussianParam* chunkData(uint32_t c) const {
+        return reinterpret_cast<const GaussianParam*>(mapped.data + chunks[c].fileOffset);
+    }
+};
+
+inline bool openChunkFile(const std::string& filename, ChunkFile& cf) {
+    if (!openMappedFile(filename, cf.mapped)) return false;
+
+    if (cf.mapped.size < sizeof(ChunkFileHeader)) {
+        printf("[Error] %s is not a .gschunk scene\n", filename.c_str());
+        closeMappedFile(cf.mapped);
+        return false;
+    }
+    cf.header = *reinterpret_cast<const ChunkFileHeader*>(cf.mapped.data);
+    if (cf.header.magic != CHUNK_FILE_MAGIC) {
+        printf("[Error] %s is not a .gschunk scene\n", filename.c_str());
+        closeMappedFile(cf.mapped);
+        return false;
+    }
+    if (cf.header.version != CHUNK_FILE_VERSION) {
+        printf("[Error] %s: unsupported version %u\n", filename.c_str(), cf.header.version);
+        closeMappedFile(cf.mapped);
+        return false;
+    }
+
+    const uint64_t tableEnd = sizeof(ChunkFileHeader) + uint64_t(cf.header.chunkCount) * sizeof(ChunkInfo);
+    bool valid = tableEnd <= cf.mapped.size;
+    if (valid) {
+        cf.chunks = reinterpret_cast<const ChunkInfo*>(cf.mapped.data + sizeof(ChunkFileHeader));
+        for (uint32_t c = 0; c < cf.header.chunkCount && valid; c++) {
+            valid = cf.chunks[c].count <= cf.header.chunkSize &&
+                    cf.chunks[c].fileOffset + uint64_t(cf.chunks[c].count) * sizeof(GaussianParam) <= cf.mapped.size;
+        }
+    }
+    if (!valid) {
+        printf("[Error] %s: truncated chunk table or data\n", filename.c_str());
+        closeMappedFile(cf.mapped);
+        cf.chunks = nullptr;
+        return false;
+    }
+    return true;
+}
+
+inline void closeChunkFile(ChunkFile& cf) {
+    closeMappedFile(cf.mapped);
+    cf.chunks = nullptr;
+}
+
+}
@@ -0,0 +1,421 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
+#include <cstdint>
+#include "common/GaussianTypes.hpp"
+#include "engine/VkEngine.hpp"
+#include "engine/VkBuffer.hpp"
+#include "engine/VkCompute.hpp"
+#include "stream/ChunkFile.hpp"
+// ============================================================
+// 파일: src/stream/ChunkResidency.hpp
+// 역할: out-of-core chunk 상주 관리 - 고정 크기 GPU pool + LRU + transfer queue 업로드
+// ============================================================
+//
+// GPU 메모리:
+//   pool  : DEVICE_LOCAL, slot × chunkSize 가우시안 (compute/transfer family CONCURRENT)
+//   table : HOST_VISIBLE, chunk마다 ResidencyEntry {slot, count}
+//           → shader가 chunk 번호로 pool 위치를 찾는 간접 테이블
+//             (slot = CHUNK_NOT_RESIDENT면 건너뜀)
+//
+// batch 1회 흐름:
+//   beginStreamBatch       완료된 async 업로드 공개
+//   requestChunk × N       view별 가시 chunk 요청 (hit = slot 갱신, miss = slot 할당 + 업로드 기록)
+//   endStreamRequests      남은 업로드 제출 → compute submit이 기다릴 semaphore 목록
+//   (render submit + wait)
+//   finishStreamBatch      이번 batch semaphore 소비 완료 → 업로드 슬롯 반납
+//
+// 업로드: mmap chunk → staging (memcpy) → vkCmdCopyBuffer (transfer queue)
+//   submit마다 fence (host 완료 확인) + binary semaphore (compute queue GPU 대기)
+//
+// 모드:
+//   blocking (기본): miss chunk도 이번 batch에 그림 → compute가 업로드 semaphore 대기
+//   async          : 이번 batch는 상주 chunk만 그림, miss는 뒤에서 업로드
+//                    → 다음 batch부터 등장 (렌더가 업로드를 기다리지 않음)
+//
+// 교체 (LRU): 빈 slot 우선, 없으면 마지막 요청 batch가 가장 오래된 slot
+//   제외: 이번 batch에 요청된 slot, 업로드가 끝나지 않은 slot
+//   slot 수 ≤ 수천 → 선형 탐색으로 충분
+// ============================================================
+
+namespace gs {
+
+const uint32_t CHUNK_NOT_RESIDENT = 0xFFFFFFFFu;
+
+// render_views.comp residency[]와 1:1 (8 bytes)
+struct ResidencyEntry {
+    uint32_t slot;
+    uint32_t count;
+};
+
+struct ChunkStreamConfig {
+    uint64_t poolBytes    = 256ull << 20;  // GPU pool 크기 (maxStorageBufferRange로 제한)
+    uint32_t uploadChunks = 32;            // transfer submit 1회당 최대 chunk 수 (= staging 크기)
+    uint32_t maxInFlight  = 8;             // async: 동시에 진행 중인 submit 상한
+    bool     async        = false;
+};
+
+struct ChunkStreamStats {
+    uint64_t requests      = 0;  // view별 가시 chunk 요청 (중복 포함)
+    uint64_t hits          = 0;  // 이미 상주
+    uint64_t misses        = 0;  // 새로 업로드
+    uint64_t pending       = 0;  // async: 업로드 진행 중이라 이번 batch에서 빠짐
+    uint64_t deferred      = 0;  // slot/staging 부족으로 이번 batch에서 빠짐
+    uint64_t evictions     = 0;
+    uint64_t submits       = 0;
+    uint64_t bytesUploaded = 0;
+    double   transferMs    = 0.0;  // submit → fence 완료 확인 (async는 polling 간격만큼 과대)
+    double   stageMs       = 0.0;  // mmap → staging memcpy (페이지 폴트 = 디스크 읽기 포함)
+};
+
+enum class UploadState {
+    Free,
+    Filling,    // copy 기록 중
+    InFlight,   // 제출됨
+    Waited,     // 이번 batch compute가 semaphore 대기 → render 끝나면 Free
+};
+
+struct ChunkUpload {
+    BufferBundle          staging;
+    uint8_t*              mapped    = nullptr;
+    VkCommandBuffer       cmd       = VK_NULL_HANDLE;
+    VkFence               fence     = VK_NULL_HANDLE;
+    VkSemaphore           semaphore = VK_NULL_HANDLE;
+    std::vector<uint32_t> chunks;
+    UploadState           state     = UploadState::Free;
+    double                submitMs  = 0.0;
+    uint64_t              bytes     = 0;
+};
+
+struct ChunkResidency {
+    ChunkFile             file;
+    ChunkStreamConfig     cfg;
+    uint32_t              slotCount    = 0;
+    uint32_t              slotCapacity = 0;   // slot당 가우시안 수 (= chunkSize)
+    VkDeviceSize          slotBytes    = 0;
+    BufferBundle          pool;
+    BufferBundle          table;
+    ResidencyEntry*       mappedTable  = nullptr;
+
+    std::vector<uint32_t> slotChunk;     // slot → chunk (CHUNK_NOT_RESIDENT = 빈 slot)
+    std::vector<uint64_t> slotLastUse;   // 마지막 요청 batch 번호
+    std::vector<uint32_t> chunkSlot;     // chunk → slot (업로드 중 포함)
+    std::vector<uint8_t>  chunkReady;    // table에 공개됨 (shader가 읽어도 됨)
+
+    VkCommandPool            commandPool = VK_NULL_HANDLE;
+    std::vector<ChunkUpload> uploads;
+    int32_t                  filling = -1;
+    std::vector<VkSemaphore> waits;      // 이번 batch compute submit 대기 목록
+    uint64_t                 frame   = 0;
+    ChunkStreamStats         stats;
+};
+
+namespace detail {
+
+inline double streamNowMs() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+inline void publishChunk(ChunkResidency& r, uint32_t chunk) {
+    r.chunkReady[chunk] = 1;
+    r.mappedTable[chunk] = ResidencyEntry{ r.chunkSlot[chunk], r.file.chunks[chunk].count };
+}
+
+inline void completeUpload(ChunkResidency& r, ChunkUpload& up) {
+    r.stats.transferMs    += streamNowMs() - up.submitMs;
+    r.stats.bytesUploaded += up.bytes;
+    if (r.cfg.async) {
+        for (uint32_t c : up.chunks) publishChunk(r, c);
+    }
+    up.state = UploadState::Waited;
+    r.waits.push_back(up.semaphore);
+}
+
+inline ChunkUpload& createUpload(const VkEngine& engine, ChunkResidency& r) {
+    VkDevice device = engine.device();
+    ChunkUpload up;
+    up.staging = createBuffer(device, engine.physicalDevice(), r.slotBytes * r.cfg.uploadChunks,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    void* mapped = nullptr;
+    vkMapMemory(device, up.staging.memory, 0, up.staging.size, 0, &mapped);
+    up.mapped = static_cast<uint8_t*>(mapped);
+
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool        = r.commandPool;
+    allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = 1;
+    if (vkAllocateCommandBuffers(device, &allocInfo, &up.cmd) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate transfer command buffer");
+    }
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    VkSemaphoreCreateInfo semInfo{};
+    semInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    if (vkCreateFence(device, &fenceInfo, nullptr, &up.fence) != VK_SUCCESS ||
+        vkCreateSemaphore(device, &semInfo, nullptr, &up.semaphore) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create upload sync objects");
+    }
+    r.uploads.push_back(up);
+    return r.uploads.back();
+}
+
+// 기록 중인 업로드 (없으면 Free 재사용 / 새로 생성, async 상한이면 nullptr)
+inline ChunkUpload* openUpload(const VkEngine& engine, ChunkResidency& r) {
+    if (r.filling >= 0) return &r.uploads[r.filling];
+
+    int32_t index = -1;
+    for (size_t i = 0; i < r.uploads.size(); i++) {
+        if (r.uploads[i].state == UploadState::Free) { index = int32_t(i); break; }
+    }
+    if (index < 0) {
+        if (r.cfg.async && r.uploads.size() >= r.cfg.maxInFlight) return nullptr;
+        createUpload(engine, r);
+        index = int32_t(r.uploads.size() - 1);
+    }
+
+    ChunkUpload& up = r.uploads[index];
+    up.chunks.clear();
+    up.bytes = 0;
+    up.state = UploadState::Filling;
+    vkResetCommandBuffer(up.cmd, 0);
+    beginOneTimeCommands(up.cmd);
+    r.filling = index;
+    return &up;
+}
+
+inline void submitUpload(const VkEngine& engine, ChunkResidency& r) {
+    if (r.filling < 0) return;
+    ChunkUpload& up = r.uploads[r.filling];
+    r.filling = -1;
+    vkEndCommandBuffer(up.cmd);
+
+    vkResetFences(engine.device(), 1, &up.fence);
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount   = 1;
+    submitInfo.pCommandBuffers      = &up.cmd;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores    = &up.semaphore;
+    if (vkQueueSubmit(engine.transferQueue(), 1, &submitInfo, up.fence) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to submit chunk upload");
+    }
+    up.state    = UploadState::InFlight;
+    up.submitMs = streamNowMs();
+    r.stats.submits++;
+}
+
+// LRU slot 선택 (이번 batch 요청 / 업로드 미완료 slot 제외)
+inline uint32_t chooseSlot(const ChunkResidency& r) {
+    uint32_t best = CHUNK_NOT_RESIDENT;
+    uint64_t bestUse = ~0ull;
+    for (uint32_t s = 0; s < r.slotCount; s++) {
+        uint32_t c = r.slotChunk[s];
+        if (c == CHUNK_NOT_RESIDENT) return s;
+        if (r.slotLastUse[s] == r.frame || !r.chunkReady[c]) continue;
+        if (r.slotLastUse[s] < bestUse) {
+            bestUse = r.slotLastUse[s];
+            best = s;
+        }
+    }
+    return best;
+}
+
+} // namespace detail
+
+// ------------------------------------------------------------
+// createChunkResidency: .gschunk 매핑 + pool/table/transfer pool 생성
+// ------------------------------------------------------------
+inline ChunkResidency createChunkResidency(
+    const VkEngine& engine,
+    const std::string& path,
+    const ChunkStreamConfig& cfg
+) {
+    VkDevice device = engine.device();
+    VkPhysicalDevice physicalDevice = engine.physicalDevice();
+
+    ChunkResidency r;
+    r.cfg = cfg;
+    r.cfg.uploadChunks = std::max(1u, cfg.uploadChunks);
+    r.cfg.maxInFlight  = std::max(1u, cfg.maxInFlight);
+    if (!openChunkFile(path, r.file)) {
+        throw std::runtime_error("Failed to open chunk file " + path);
+    }
+    const ChunkFileHeader& h = r.file.header;
+    r.slotCapacity = h.chunkSize;
+    r.slotBytes    = VkDeviceSize(h.chunkSize) * sizeof(GaussianParam);
+
+    // pool 전체가 SSBO 하나로 바인딩 → maxStorageBufferRange 이하
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(physicalDevice, &props);
+    uint64_t poolBytes = cfg.poolBytes;
+    if (poolBytes > props.limits.maxStorageBufferRange) {
+        printf("[Stream] Pool clamped to maxStorageBufferRange (%u MB)\n",
+            props.limits.maxStorageBufferRange >> 20);
+        poolBytes = props.limits.maxStorageBufferRange;
+    }
+    r.slotCount = uint32_t(std::min<uint64_t>(std::max<uint64_t>(1, poolBytes / r.slotBytes),
+        std::max(1u, h.chunkCount)));
+
+    r.pool = createBuffer(device, physicalDevice, VkDeviceSize(r.slotCount) * r.slotBytes,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        { engine.computeQueueFamily(), engine.transferQueueFamily() });
+    r.table = createBuffer(device, physicalDevice,
+        std::max<VkDeviceSize>(16, VkDeviceSize(h.chunkCount) * sizeof(ResidencyEntry)),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    void* mapped = nullptr;
+    vkMapMemory(device, r.table.memory, 0, r.table.size, 0, &mapped);
+    r.mappedTable = static_cast<ResidencyEntry*>(mapped);
+    for (uint32_t c = 0; c < h.chunkCount; c++) r.mappedTable[c] = ResidencyEntry{ CHUNK_NOT_RESIDENT, 0 };
+
+    r.slotChunk.assign(r.slotCount, CHUNK_NOT_RESIDENT);
+    r.slotLastUse.assign(r.slotCount, 0);
+    r.chunkSlot.assign(h.chunkCount, CHUNK_NOT_RESIDENT);
+    r.chunkReady.assign(h.chunkCount, 0);
+
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.queueFamilyIndex = engine.transferQueueFamily();
+    poolInfo.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    if (vkCreateCommandPool(device, &poolInfo, nullptr, &r.commandPool) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create transfer command pool");
+    }
+
+    printf("[Stream] %s: %u chunks × %u gaussians (%.1f MB on disk), pool %u slots (%.1f MB)%s\n",
+        path.c_str(), h.chunkCount, h.chunkSize, double(r.file.mapped.size) / (1024.0 * 1024.0),
+        r.slotCount, double(r.pool.size) / (1024.0 * 1024.0), r.cfg.async ? ", async" : "");
+    return r;
+}
+
+inline void destroyChunkResidency(VkDevice device, ChunkResidency& r) {
+    vkDeviceWaitIdle(device);
+    for (auto& up : r.uploads) {
+        vkUnmapMemory(device, up.staging.memory);
+        destroyBuffer(device, up.staging);
+        vkDestroyFence(device, up.fence, nullptr);
+        vkDestroySemaphore(device, up.semaphore, nullptr);
+    }
+    r.uploads.clear();
+    if (r.commandPool != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(device, r.commandPool, nullptr);
+        r.commandPool = VK_NULL_HANDLE;
+    }
+    vkUnmapMemory(device, r.table.memory);
+    destroyBuffer(device, r.table);
+    destroyBuffer(device, r.pool);
+    closeChunkFile(r.file);
+}
+
+// ------------------------------------------------------------
+// beginStreamBatch: batch 번호 증가 + (async) 끝난 업로드 공개
+// ------------------------------------------------------------
+inline void beginStreamBatch(VkDevice device, ChunkResidency& r) {
+    r.frame++;
+    r.waits.clear();
+    if (!r.cfg.async) return;
+    for (auto& up : r.uploads) {
+        if (up.state == UploadState::InFlight && vkGetFenceStatus(device, up.fence) == VK_SUCCESS) {
+            detail::completeUpload(r, up);
+        }
+    }
+}
+
+// ------------------------------------------------------------
+// requestChunk: view가 chunk를 본다 → 상주 확인 / 업로드 기록
+// ------------------------------------------------------------
+// 그릴 수 있는지는 table이 결정 (blocking: 업로드 기록 즉시 공개,
+// async: 업로드 완료 후 다음 beginStreamBatch에서 공개)
+// ------------------------------------------------------------
+inline void requestChunk(const VkEngine& engine, ChunkResidency& r, uint32_t chunk) {
+    r.stats.requests++;
+
+    uint32_t slot = r.chunkSlot[chunk];
+    if (slot != CHUNK_NOT_RESIDENT) {
+        r.slotLastUse[slot] = r.frame;
+        if (r.chunkReady[chunk]) r.stats.hits++;
+        else                     r.stats.pending++;
+        return;
+    }
+
+    slot = detail::chooseSlot(r);
+    ChunkUpload* up = (slot != CHUNK_NOT_RESIDENT) ? detail::openUpload(engine, r) : nullptr;
+    if (!up) {
+        r.stats.deferred++;
+        return;
+    }
+
+    // ---------- 교체 ----------
+    uint32_t old = r.slotChunk[slot];
+    if (old != CHUNK_NOT_RESIDENT) {
+        r.chunkSlot[old]   = CHUNK_NOT_RESIDENT;
+        r.chunkReady[old]  = 0;
+        r.mappedTable[old] = ResidencyEntry{ CHUNK_NOT_RESIDENT, 0 };
+        r.stats.evictions++;
+    }
+    r.slotChunk[slot]   = chunk;
+    r.slotLastUse[slot] = r.frame;
+    r.chunkSlot[chunk]  = slot;
+
+    // ---------- mmap → staging → pool slot ----------
+    const VkDeviceSize bytes = VkDeviceSize(r.file.chunks[chunk].count) * sizeof(GaussianParam);
+    const VkDeviceSize stagingOffset = VkDeviceSize(up->chunks.size()) * r.slotBytes;
+    double t0 = detail::streamNowMs();
+    memcpy(up->mapped + stagingOffset, r.file.chunkData(chunk), size_t(bytes));
+    r.stats.stageMs += detail::streamNowMs() - t0;
+
+    if (bytes > 0) {
+        VkBufferCopy region{ stagingOffset, VkDeviceSize(slot) * r.slotBytes, bytes };
+        vkCmdCopyBuffer(up->cmd, up->staging.buffer, r.pool.buffer, 1, &region);
+    }
+    up->chunks.push_back(chunk);
+    up->bytes += bytes;
+    r.stats.misses++;
+
+    if (!r.cfg.async) detail::publishChunk(r, chunk);
+    if (up->chunks.size() >= r.cfg.uploadChunks) detail::submitUpload(engine, r);
+}
+
+// ------------------------------------------------------------
+// endStreamRequests: 남은 업로드 제출 → compute submit 대기 목록
+// ------------------------------------------------------------
+// blocking: 이번 batch 업로드 완료를 host에서 확인 (전송 시간 측정)
+//           + compute가 semaphore로 GPU 쪽 순서/가시성 보장
+// ------------------------------------------------------------
+inline const std::vector<VkSemaphore>& endStreamRequests(const VkEngine& engine, ChunkResidency& r) {
+    detail::submitUpload(engine, r);
+    if (!r.cfg.async) {
+        for (auto& up : r.uploads) {
+            if (up.state != UploadState::InFlight) continue;
+            vkWaitForFences(engine.device(), 1, &up.fence, VK_TRUE, UINT64_MAX);
+            detail::completeUpload(r, up);
+        }
+    }
+    return r.waits;
+}
+
+// render submit 완료 후: 이번 batch가 소비한 semaphore의 업로드 반납
+inline void finishStreamBatch(ChunkResidency& r) {
+    for (auto& up : r.uploads) {
+        if (up.state == UploadState::Waited) up.state = UploadState::Free;
+    }
+    r.waits.clear();
+}
+
+inline uint32_t residentChunkCount(const ChunkResidency& r) {
+    uint32_t n = 0;
+    for (uint32_t c : r.slotChunk) n += (c != CHUNK_NOT_RESIDENT) ? 1u : 0u;
+    return n;
+}
+
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+// ============================================================
+// 파일: src/stream/MappedFile.hpp
+// 역할: 읽기 전용 memory-mapped 파일 (POSIX mmap / Win32 file mapping)
+// ============================================================
+//
+// 장면 파일 전체를 주소 공간에만 매핑 → 실제 읽기는 페이지 단위로 OS가 처리
+// RAM보다 큰 장면도 필요한 chunk 페이지만 메모리에 올라옴
+//
+// 접근 패턴이 view에 따라 랜덤 → POSIX에서는 MADV_RANDOM (readahead 끔)
+// ============================================================
+
+namespace gs {
+
+struct MappedFile {
+    const uint8_t* data = nullptr;
+    size_t         size = 0;
+#ifdef _WIN32
+    HANDLE         file    = INVALID_HANDLE_VALUE;
+    HANDLE         mapping = nullptr;
+#else
+    int            fd = -1;
+#endif
+};
+
+inline void closeMappedFile(MappedFile& mf) {
+#ifdef _WIN32
+    if (mf.data) UnmapViewOfFile(mf.data);
+    if (mf.mapping) CloseHandle(mf.mapping);
+    if (mf.file != INVALID_HANDLE_VALUE) CloseHandle(mf.file);
+    mf.mapping = nullptr;
+    mf.file = INVALID_HANDLE_VALUE;
+#else
+    if (mf.data) munmap(const_cast<uint8_t*>(mf.data), mf.size);
+    if (mf.fd >= 0) close(mf.fd);
+    mf.fd = -1;
+#endif
+    mf.data = nullptr;
+    mf.size = 0;
+}
+
+inline bool openMappedFile(const std::string& filename, MappedFile& mf) {
+    closeMappedFile(mf);
+#ifdef _WIN32
+    mf.file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (mf.file == INVALID_HANDLE_VALUE) {
+        printf("[Error] Cannot open %s\n", filename.c_str());
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(mf.file, &fileSize) || fileSize.QuadPart == 0) {
+        printf("[Error] %s is empty\n", filename.c_str());
+        closeMappedFile(mf);
+        return false;
+    }
+    mf.size = size_t(fileSize.QuadPart);
+    mf.mapping = CreateFileMappingA(mf.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mf.mapping) {
+        mf.data = static_cast<const uint8_t*>(MapViewOfFile(mf.mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+#else
+    mf.fd = open(filename.c_str(), O_RDONLY);
+    if (mf.fd < 0) {
+        printf("[Error] Cannot open %s\n", filename.c_str());
+        return false;
+    }
+    struct stat st;
+    if (fstat(mf.fd, &st) != 0 || st.st_size == 0) {
+        printf("[Error] %s is empty\n", filename.c_str());
+        closeMappedFile(mf);
+        return false;
+    }
+    mf.size = size_t(st.st_size);
+    void* p = mmap(nullptr, mf.size, PROT_READ, MAP_SHARED, mf.fd, 0);
+    if (p != MAP_FAILED) {
+        mf.data = static_cast<const uint8_t*>(p);
+        madvise(p, mf.size, MADV_RANDOM);
+    }
+#endif
+    if (!mf.data) {
+        printf("[Error] Cannot map %s\n", filename.c_str());
+        mf.size = 0;
+        closeMappedFile(mf);
+        return false;
+    }
+    return true;
+}
+
+}
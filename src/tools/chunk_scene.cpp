@@ -0,0 +1,94 @@
+// ============================================================
+// File: src/tools/chunk_scene.cpp
+// Role: 장면 → out-of-core chunk 파일 (.gschunk) 변환
+// ============================================================
+//
+// 입력: 학습 결과 .gsplat 또는 합성 장면
+// 출력: Morton 순 chunk 파일 (gaussian_serve --stream 입력)
+//
+// 실행 예시 (build 폴더 기준):
+//   gaussian_chunk --scene ../ppmOutput/scene.gsplat --out scene.gschunk
+//   gaussian_chunk --synthetic 5e7 --extent 131072 --chunk-size 8192 --out big.gschunk
+// ============================================================
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+
+#include "common/GaussianTypes.hpp"
+#include "common/SceneGen.hpp"
+#include "common/SceneIO.hpp"
+#include "stream/ChunkFile.hpp"
+
+namespace {
+
+struct ChunkToolConfig {
+    std::string scenePath;
+    uint32_t    syntheticCount = 100000;
+    uint32_t    extent         = 4096;
+    uint32_t    chunkSize      = 4096;
+    std::string outPath        = "scene.gschunk";
+};
+
+void printUsage() {
+    fprintf(stderr,
+        "Usage: gaussian_chunk [options]\n"
+        "  --scene FILE          .gsplat scene (default: synthetic)\n"
+        "  --synthetic N         synthetic scene size (default 100000)\n"
+        "  --extent PX           synthetic scene extent (default 4096)\n"
+        "  --chunk-size N        gaussians per chunk (default 4096)\n"
+        "  --out FILE            output .gschunk (default scene.gschunk)\n");
+}
+
+ChunkToolConfig parseArgs(int argc, char** argv) {
+    ChunkToolConfig cfg;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        auto next = [&]() -> const char* {
+            if (i + 1 >= argc) throw std::runtime_error("Missing value for " + a);
+            return argv[++i];
+        };
+        if      (a == "--scene")      cfg.scenePath = next();
+        else if (a == "--synthetic")  cfg.syntheticCount = uint32_t(std::strtod(next(), nullptr));
+        else if (a == "--extent")     cfg.extent = uint32_t(std::max(1, std::atoi(next())));
+        else if (a == "--chunk-size") cfg.chunkSize = uint32_t(std::max(1, std::atoi(next())));
+        else if (a == "--out")        cfg.outPath = next();
+        else if (a == "--help" || a == "-h") { printUsage(); std::exit(0); }
+        else throw std::runtime_error("Unknown option: " + a);
+    }
+    return cfg;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ChunkToolConfig cfg;
+    try {
+        cfg = parseArgs(argc, argv);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "[Error] %s\n", e.what());
+        printUsage();
+        return 1;
+    }
+
+    gs::Scene scene;
+    if (!cfg.scenePath.empty()) {
+        if (!gs::loadScene(cfg.scenePath, scene)) return 1;
+    } else {
+        gs::SceneGenConfig gen;
+        gen.count = cfg.syntheticCount;
+        gen.width = gen.height = cfg.extent;
+        scene.gaussians = gs::generateScene(gen);
+        scene.width = scene.height = cfg.extent;
+    }
+    printf("[Chunk] Scene: %zu gaussians, extent %ux%u\n",
+        scene.gaussians.size(), scene.width, scene.height);
+
+    auto t0 = std::chrono::steady_clock::now();
+    if (!gs::writeChunkFile(cfg.outPath, scene, cfg.chunkSize)) return 1;
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    printf("[Chunk] Done in %.1f ms\n", ms);
+    return 0;
+}
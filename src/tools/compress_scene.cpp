@@ -0,0 +1,298 @@
+// ============================================================
+// File: src/tools/compress_scene.cpp
+// Role: 학습 후 압축 (.gsplat → .gscomp) + 품질/크기/렌더 속도 리포트
+// ============================================================
+//
+// 1. 장면 로드 (.gsplat 또는 합성)
+// 2. compressScene: Morton chunk 위치 양자화 + scale/rotation/color codebook
+// 3. 저장 → 다시 로드 (loader 시간 측정 + 왕복 검증)
+// 4. 리포트:
+//      크기   : 원본 (64 B/가우시안) vs 압축 (header + codebook + chunk + 8 B/가우시안)
+//      속성 오차: scale 상대 오차, rotation (1 - |q'·q|), color/opacity RMSE, 위치 최대 오차
+//      --render: 같은 view batch를 원본(Morton 순) / 압축 RenderService로 렌더
+//                → GPU render ms (timestamp, 반복 중앙값) + 이미지 PSNR (RGBA8 readback)
+//      --json  : 같은 숫자를 JSON으로
+//
+// 실행 예시 (build 폴더 기준):
+//   gaussian_compress --scene ../ppmOutput/scene.gsplat --out scene.gscomp --render
+//   gaussian_compress --synthetic 1e6 --extent 8192 --render --device llvmpipe --json compress.json
+// ============================================================
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+
+#include "common/GaussianTypes.hpp"
+#include "common/SceneGen.hpp"
+#include "common/SceneIO.hpp"
+#include "compress/CompressedScene.hpp"
+#include "engine/VkEngine.hpp"
+#include "serve/RenderService.hpp"
+#include "utils/JsonIO.hpp"
+
+namespace {
+
+struct CompressToolConfig {
+    std::string scenePath;
+    uint32_t    syntheticCount = 100000;
+    uint32_t    extent         = 2048;
+    std::string outPath        = "scene.gscomp";
+    gs::CompressConfig compress;
+    bool        render         = false;
+    uint32_t    views          = 4;
+    uint32_t    viewSize       = 512;
+    uint32_t    reps           = 10;
+    std::string device;
+    std::string shaderDir      = "../src/shaders/";
+    std::string jsonPath;
+};
+
+void printUsage() {
+    fprintf(stderr,
+        "Usage: gaussian_compress [options]\n"
+        "  --scene FILE          .gsplat scene (default: synthetic)\n"
+        "  --synthetic N         synthetic scene size (default 100000)\n"
+        "  --extent PX           synthetic scene extent (default 2048)\n"
+        "  --out FILE            output .gscomp (default scene.gscomp)\n"
+        "  --chunk-size N        gaussians per position chunk (default 256)\n"
+        "  --k N                 codebook entries per attribute, <= 256 (default 256)\n"
+        "  --kmeans-iters N      Lloyd iterations (default 12)\n"
+        "  --kmeans-samples N    training sample size (default 65536)\n"
+        "  --render              GPU render comparison (PSNR, render ms)\n"
+        "  --views N             views in the comparison batch (default 4)\n"
+        "  --view-size PX        view width/height (default 512)\n"
+        "  --reps N              timed batches (default 10)\n"
+        "  --device NAME         device name substring (e.g. llvmpipe)\n"
+        "  --shaders DIR         SPIR-V directory (default ../src/shaders/)\n"
+        "  --json FILE           write the report as JSON\n");
+}
+
+CompressToolConfig parseArgs(int argc, char** argv) {
+    CompressToolConfig cfg;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        auto next = [&]() -> const char* {
+            if (i + 1 >= argc) throw std::runtime_error("Missing value for " + a);
+            return argv[++i];
+        };
+        if      (a == "--scene")          cfg.scenePath = next();
+        else if (a == "--synthetic")      cfg.syntheticCount = uint32_t(std::strtod(next(), nullptr));
+        else if (a == "--extent")         cfg.extent = uint32_t(std::max(1, std::atoi(next())));
+        else if (a == "--out")            cfg.outPath = next();
+        else if (a == "--chunk-size")     cfg.compress.chunkSize = uint32_t(std::max(1, std::atoi(next())));
+        else if (a == "--k")              cfg.compress.kmeans.k = uint32_t(std::clamp(std::atoi(next()), 1, 256));
+        else if (a == "--kmeans-iters")   cfg.compress.kmeans.iterations = uint32_t(std::max(0, std::atoi(next())));
+        else if (a == "--kmeans-samples") cfg.compress.kmeans.sampleCount = uint32_t(std::max(1.0, std::strtod(next(), nullptr)));
+        else if (a == "--render")         cfg.render = true;
+        else if (a == "--views")          cfg.views = uint32_t(std::max(1, std::atoi(next())));
+        else if (a == "--view-size")      cfg.viewSize = uint32_t(std::max(8, std::atoi(next())));
+        else if (a == "--reps")           cfg.reps = uint32_t(std::max(1, std::atoi(next())));
+        else if (a == "--device")         cfg.device = next();
+        else if (a == "--shaders")        cfg.shaderDir = next();
+        else if (a == "--json")           cfg.jsonPath = next();
+        else if (a == "--help" || a == "-h") { printUsage(); std::exit(0); }
+        else throw std::runtime_error("Unknown option: " + a);
+    }
+    return cfg;
+}
+
+double median(std::vector<double> v) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[v.size() / 2];
+}
+
+// ------------------------------------------------------------
+// 렌더 비교 결과
+// ------------------------------------------------------------
+struct RenderReport {
+    bool   done         = false;
+    double psnr         = 0.0;
+    double rawMs        = 0.0;   // render_views 중앙값 (원본)
+    double compressedMs = 0.0;   // render_views 중앙값 (압축)
+    std::string deviceName;
+};
+
+// view grid: 장면 범위를 g × g 칸으로 나눠 칸마다 view 1개 (zoom = viewSize / 칸 크기)
+void setupViews(gs::RenderService& rs, uint32_t views, uint32_t viewSize, uint32_t width, uint32_t height) {
+    uint32_t grid = uint32_t(std::ceil(std::sqrt(double(views))));
+    float cellW = float(width) / float(grid);
+    float cellH = float(height) / float(grid);
+    for (uint32_t v = 0; v < views; v++) {
+        gs::ViewCamera cam{};
+        cam.center      = glm::vec2((float(v % grid) + 0.5f) * cellW, (float(v / grid) + 0.5f) * cellH);
+        cam.zoom        = float(viewSize) / std::max(cellW, cellH);
+        cam.angle       = 0.0f;
+        cam.width       = viewSize;
+        cam.height      = viewSize;
+        cam.pixelOffset = v * viewSize * viewSize;
+        rs.mappedViews[v] = cam;
+    }
+}
+
+double timeBatches(const gs::VkEngine& engine, gs::RenderService& rs, const CompressToolConfig& cfg,
+                   uint32_t width, uint32_t height) {
+    setupViews(rs, cfg.views, cfg.viewSize, width, height);
+    gs::renderBatch(engine, rs, cfg.views);  // warmup
+    std::vector<double> ms;
+    for (uint32_t r = 0; r < cfg.reps; r++) {
+        ms.push_back(gs::renderBatch(engine, rs, cfg.views).renderMs);
+    }
+    return median(ms);
+}
+
+RenderReport runRenderReport(
+    const CompressToolConfig& cfg,
+    const std::vector<gs::GaussianParam>& sorted,
+    const gs::CompressedScene& cs
+) {
+    RenderReport report;
+    uint32_t width  = std::max(1u, cs.header.width);
+    uint32_t height = std::max(1u, cs.header.height);
+
+    gs::VkEngine engine;
+    gs::RenderService rawRS, compRS;
+    try {
+        engine.init(nullptr, cfg.device.empty() ? nullptr : cfg.device.c_str());
+        gs::RenderServiceConfig rsCfg;
+        rsCfg.maxViews  = cfg.views;
+        rsCfg.maxPixels = cfg.views * cfg.viewSize * cfg.viewSize;
+        rawRS  = gs::createRenderService(engine, cfg.shaderDir, sorted, rsCfg);
+        compRS = gs::createRenderService(engine, cfg.shaderDir, {}, rsCfg, &cs);
+    } catch (const std::exception& e) {
+        printf("[Error] %s\n", e.what());
+        return report;
+    }
+    report.deviceName = engine.deviceName();
+
+    report.rawMs        = timeBatches(engine, rawRS, cfg, width, height);
+    report.compressedMs = timeBatches(engine, compRS, cfg, width, height);
+
+    // 마지막 batch readback 비교 (RGB만, alpha는 항상 255)
+    const size_t pixels = size_t(cfg.views) * cfg.viewSize * cfg.viewSize;
+    double sq = 0.0;
+    for (size_t i = 0; i < pixels; i++) {
+        for (size_t c = 0; c < 3; c++) {
+            double d = double(rawRS.mappedReadback[i * 4 + c]) - double(compRS.mappedReadback[i * 4 + c]);
+            sq += d * d;
+        }
+    }
+    double mse = sq / double(std::max<size_t>(1, pixels * 3));
+    report.psnr = (mse > 0.0) ? 10.0 * std::log10(255.0 * 255.0 / mse) : 99.0;
+    report.done = true;
+
+    gs::destroyRenderService(engine.device(), rawRS);
+    gs::destroyRenderService(engine.device(), compRS);
+    engine.cleanup();
+    return report;
+}
+
+bool writeJson(const std::string& path, const CompressToolConfig& cfg, const gs::CompressedScene& cs,
+               const gs::CompressStats& st, double loadMs, const RenderReport& rr) {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        printf("[Error] Cannot open %s\n", path.c_str());
+        return false;
+    }
+    const double rawBytes  = double(sizeof(gs::SceneFileHeader)) + double(cs.header.count) * sizeof(gs::GaussianParam);
+    const double compBytes = double(gs::compressedFileBytes(cs));
+    std::fprintf(f, "{\n");
+    std::fprintf(f, "  \"schema\": 1,\n");
+    std::fprintf(f, "  \"gaussians\": %u,\n", cs.header.count);
+    std::fprintf(f, "  \"config\": { \"chunk_size\": %u, \"k\": %u, \"iterations\": %u, \"samples\": %u },\n",
+        cfg.compress.chunkSize, cfg.compress.kmeans.k, cfg.compress.kmeans.iterations, cfg.compress.kmeans.sampleCount);
+    std::fprintf(f, "  \"size\": { \"raw_bytes\": %.0f, \"compressed_bytes\": %.0f, \"ratio\": %.3f, "
+        "\"bytes_per_gaussian\": %.3f },\n", rawBytes, compBytes, rawBytes / std::max(1.0, compBytes),
+        compBytes / std::max(1u, cs.header.count));
+    std::fprintf(f, "  \"error\": { \"scale_rel\": %.6f, \"rotation\": %.6f, \"color_rmse\": %.6f, "
+        "\"opacity_rmse\": %.6f, \"position_max_px\": %.6f },\n",
+        st.scaleRelErr, st.rotationErr, st.colorRmse, st.opacityRmse, st.positionMaxErr);
+    std::fprintf(f, "  \"timing_ms\": { \"compress\": %.3f, \"load\": %.3f }", st.buildMs, loadMs);
+    if (rr.done) {
+        std::fprintf(f, ",\n  \"render\": { \"device\": \"%s\", \"views\": %u, \"view_size\": %u, \"reps\": %u, "
+            "\"raw_ms\": %.6f, \"compressed_ms\": %.6f, \"speedup\": %.3f, \"psnr_db\": %.3f }\n",
+            gs::jsonEscape(rr.deviceName).c_str(), cfg.views, cfg.viewSize, cfg.reps, rr.rawMs, rr.compressedMs,
+            rr.compressedMs > 0.0 ? rr.rawMs / rr.compressedMs : 0.0, rr.psnr);
+    } else {
+        std::fprintf(f, "\n");
+    }
+    std::fprintf(f, "}\n");
+    std::fclose(f);
+    printf("[OK] Saved %s\n", path.c_str());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    CompressToolConfig cfg;
+    try {
+        cfg = parseArgs(argc, argv);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "[Error] %s\n", e.what());
+        printUsage();
+        return 1;
+    }
+
+    gs::Scene scene;
+    if (!cfg.scenePath.empty()) {
+        if (!gs::loadScene(cfg.scenePath, scene)) return 1;
+    } else {
+        gs::SceneGenConfig gen;
+        gen.count = cfg.syntheticCount;
+        gen.width = gen.height = cfg.extent;
+        scene.gaussians = gs::generateScene(gen);
+        scene.width = scene.height = cfg.extent;
+    }
+    printf("[Compress] Scene: %zu gaussians, extent %ux%u\n",
+        scene.gaussians.size(), scene.width, scene.height);
+
+    // ============================================================
+    // 압축 → 저장 → 다시 로드
+    // ============================================================
+    gs::CompressedScene cs;
+    std::vector<gs::GaussianParam> sorted;
+    gs::CompressStats st = gs::compressScene(scene, cfg.compress, cs, &sorted);
+    if (!gs::saveCompressedScene(cfg.outPath, cs)) return 1;
+
+    auto t0 = std::chrono::steady_clock::now();
+    gs::CompressedScene loaded;
+    if (!gs::loadCompressedScene(cfg.outPath, loaded)) return 1;
+    double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    if (loaded.gaussians.size() != cs.gaussians.size() ||
+        !std::equal(loaded.gaussians.begin(), loaded.gaussians.end(), cs.gaussians.begin(),
+            [](const gs::CompressedGaussian& a, const gs::CompressedGaussian& b) {
+                return a.position == b.position && a.attributes == b.attributes;
+            })) {
+        printf("[Error] Round-trip mismatch in %s\n", cfg.outPath.c_str());
+        return 1;
+    }
+
+    RenderReport rr;
+    if (cfg.render) rr = runRenderReport(cfg, sorted, loaded);
+
+    // ============================================================
+    // 리포트
+    // ============================================================
+    const double rawBytes  = double(sizeof(gs::SceneFileHeader)) + double(cs.header.count) * sizeof(gs::GaussianParam);
+    const double compBytes = double(gs::compressedFileBytes(cs));
+    printf("\n=== Compression Report ===\n");
+    printf("  size       : %.2f MB -> %.2f MB (%.2fx, %.2f B/gaussian)\n",
+        rawBytes / (1024.0 * 1024.0), compBytes / (1024.0 * 1024.0),
+        rawBytes / std::max(1.0, compBytes), compBytes / std::max(1u, cs.header.count));
+    printf("  error      : scale %.2f%% | rotation %.5f | color rmse %.4f | opacity rmse %.4f | position max %.4f px\n",
+        st.scaleRelErr * 100.0, st.rotationErr, st.colorRmse, st.opacityRmse, st.positionMaxErr);
+    printf("  time       : compress %.1f ms, load %.2f ms\n", st.buildMs, loadMs);
+    if (rr.done) {
+        printf("  render     : raw %.3f ms | compressed %.3f ms (%.2fx) | PSNR %.2f dB  [%u × %ux%u, %s]\n",
+            rr.rawMs, rr.compressedMs, rr.compressedMs > 0.0 ? rr.rawMs / rr.compressedMs : 0.0, rr.psnr,
+            cfg.views, cfg.viewSize, cfg.viewSize, rr.deviceName.c_str());
+    }
+
+    if (!cfg.jsonPath.empty() && !writeJson(cfg.jsonPath, cfg, cs, st, loadMs, rr)) return 1;
+    return 0;
+}
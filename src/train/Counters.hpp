@@ -0,0 +1,160 @@
+// ============================================================
+// File: src/train/Counters.hpp
+// Role: 계측 빌드 블록 카운터 집계 (gaussian.comp / backward.comp INSTRUMENT)
+//       → 합계, 블록 간 불균형, 낭비 평가 비율, 히스토그램, heatmap PPM
+// ============================================================
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+
+#include "engine/VkBuffer.hpp"
+#include "train/TrainPasses.hpp"
+#include "utils/ImageIO.hpp"
+
+namespace gs {
+
+// shader uvec4 counters[] 1칸 = 8×8 픽셀 블록 1개
+struct BlockCounters {
+    uint32_t evaluated;    // 평가한 가우시안 (픽셀 합)
+    uint32_t significant;  // alpha > 1/255
+    uint32_t earlyTerm;    // T < 0.001로 끝난 픽셀 수
+    uint32_t atomics;      // 발행한 atomic 수
+};
+
+static_assert(sizeof(BlockCounters) == 16, "BlockCounters must match shader uvec4");
+
+const uint32_t COUNTER_HISTOGRAM_BINS = 16;
+
+struct CounterGrid {
+    uint32_t width   = 0;  // dispatch 해상도 (pyramid level이면 level 크기)
+    uint32_t height  = 0;
+    uint32_t blocksX = 0;
+    uint32_t blocksY = 0;
+    std::vector<BlockCounters> blocks;
+
+    // 가장자리 블록은 8×8보다 작음
+    uint32_t blockPixels(uint32_t bx, uint32_t by) const {
+        return std::min(COUNTER_BLOCK, width - bx * COUNTER_BLOCK) *
+               std::min(COUNTER_BLOCK, height - by * COUNTER_BLOCK);
+    }
+};
+
+// 제출 완료 후 호출 (counters는 HOST_VISIBLE)
+inline CounterGrid readCounterGrid(VkDevice device, BufferBundle& counters, uint32_t width, uint32_t height) {
+    CounterGrid grid;
+    grid.width   = width;
+    grid.height  = height;
+    grid.blocksX = (width + COUNTER_BLOCK - 1) / COUNTER_BLOCK;
+    grid.blocksY = (height + COUNTER_BLOCK - 1) / COUNTER_BLOCK;
+    grid.blocks.resize(size_t(grid.blocksX) * grid.blocksY);
+    downloadFromBuffer(device, counters, grid.blocks.data(), grid.blocks.size() * sizeof(BlockCounters));
+    return grid;
+}
+
+// ------------------------------------------------------------
+// CounterSummary: 활성 블록(evaluated > 0) 기준 통계
+// ------------------------------------------------------------
+// imbalance      = 블록당 평가 수 max / mean (1 = 균등, 클수록 느린 workgroup이 전체를 붙잡음)
+// wastedFraction = 1 - significant / evaluated (exp 계산했지만 색에 기여 안 한 비율)
+// histogram      = 블록별 픽셀당 평가 수 분포, [0, maxPerPixel] 균등 구간
+// ------------------------------------------------------------
+struct CounterSummary {
+    uint64_t evaluated   = 0;
+    uint64_t significant = 0;
+    uint64_t earlyTerm   = 0;
+    uint64_t atomics     = 0;
+    uint64_t pixels      = 0;
+    uint32_t activeBlocks = 0;
+    double   meanPerBlock = 0.0;
+    double   maxPerBlock  = 0.0;
+    double   imbalance    = 0.0;
+    double   wastedFraction    = 0.0;
+    double   earlyTermFraction = 0.0;
+    double   maxPerPixel  = 0.0;
+    std::vector<uint32_t> histogram;
+};
+
+inline CounterSummary summarizeCounters(const CounterGrid& grid) {
+    CounterSummary s;
+    s.histogram.assign(COUNTER_HISTOGRAM_BINS, 0);
+
+    std::vector<double> perPixel;
+    perPixel.reserve(grid.blocks.size());
+    for (uint32_t by = 0; by < grid.blocksY; by++) {
+        for (uint32_t bx = 0; bx < grid.blocksX; bx++) {
+            const BlockCounters& c = grid.blocks[size_t(by) * grid.blocksX + bx];
+            if (c.evaluated == 0) continue;
+            const uint32_t px = grid.blockPixels(bx, by);
+            s.evaluated   += c.evaluated;
+            s.significant += c.significant;
+            s.earlyTerm   += c.earlyTerm;
+            s.atomics     += c.atomics;
+            s.pixels      += px;
+            s.activeBlocks++;
+            s.maxPerBlock = std::max(s.maxPerBlock, double(c.evaluated));
+            perPixel.push_back(double(c.evaluated) / px);
+        }
+    }
+    if (s.activeBlocks == 0) return s;
+
+    s.meanPerBlock      = double(s.evaluated) / s.activeBlocks;
+    s.imbalance         = s.maxPerBlock / s.meanPerBlock;
+    s.wastedFraction    = 1.0 - double(s.significant) / double(s.evaluated);
+    s.earlyTermFraction = double(s.earlyTerm) / double(s.pixels);
+    s.maxPerPixel       = *std::max_element(perPixel.begin(), perPixel.end());
+    for (double v : perPixel) {
+        uint32_t bin = uint32_t(v / s.maxPerPixel * COUNTER_HISTOGRAM_BINS);
+        s.histogram[std::min(bin, COUNTER_HISTOGRAM_BINS - 1)]++;
+    }
+    return s;
+}
+
+inline void printCounterSummary(const char* label, const CounterSummary& s) {
+    printf("    [%s] %u blocks | eval %llu (%.1f/px) | wasted %.1f%% | early-term %.1f%% px | atomics %llu | imbalance %.2f\n",
+        label, s.activeBlocks, (unsigned long long)s.evaluated,
+        s.pixels ? double(s.evaluated) / double(s.pixels) : 0.0,
+        100.0 * s.wastedFraction, 100.0 * s.earlyTermFraction,
+        (unsigned long long)s.atomics, s.imbalance);
+    printf("    [%s] eval/px histogram (0 .. %.1f):", label, s.maxPerPixel);
+    for (uint32_t count : s.histogram) printf(" %u", count);
+    printf("\n");
+}
+
+// ------------------------------------------------------------
+// saveCounterHeatmaps: prefix_{evaluated,wasted,early}.ppm (+ _atomics)
+// ------------------------------------------------------------
+// 블록 1개 = 8×8 픽셀로 확대 → 렌더 이미지와 같은 크기
+// evaluated: 픽셀당 평가 수 (최대값 = 흰색), wasted/early: 비율 [0, 1]
+// ------------------------------------------------------------
+inline bool saveCounterHeatmaps(const std::string& prefix, const CounterGrid& grid) {
+    const size_t n = grid.blocks.size();
+    std::vector<float> evaluated(n, 0.0f), wasted(n, 0.0f), early(n, 0.0f), atomics(n, 0.0f);
+    bool anyAtomics = false;
+    for (uint32_t by = 0; by < grid.blocksY; by++) {
+        for (uint32_t bx = 0; bx < grid.blocksX; bx++) {
+            const size_t i = size_t(by) * grid.blocksX + bx;
+            const BlockCounters& c = grid.blocks[i];
+            if (c.evaluated == 0) continue;
+            const float px = float(grid.blockPixels(bx, by));
+            evaluated[i] = float(c.evaluated) / px;
+            wasted[i]    = 1.0f - float(c.significant) / float(c.evaluated);
+            early[i]     = float(c.earlyTerm) / px;
+            atomics[i]   = float(c.atomics) / px;
+            anyAtomics  |= (c.atomics != 0);
+        }
+    }
+    bool ok = saveHeatmapPPM(prefix + "_evaluated.ppm", evaluated, grid.blocksX, grid.blocksY, 0.0f, COUNTER_BLOCK);
+    ok &= saveHeatmapPPM(prefix + "_wasted.ppm", wasted, grid.blocksX, grid.blocksY, 1.0f, COUNTER_BLOCK);
+    ok &= saveHeatmapPPM(prefix + "_early.ppm", early, grid.blocksX, grid.blocksY, 1.0f, COUNTER_BLOCK);
+    if (anyAtomics) {
+        ok &= saveHeatmapPPM(prefix + "_atomics.ppm", atomics, grid.blocksX, grid.blocksY, 0.0f, COUNTER_BLOCK);
+    }
+    return ok;
+}
+
+} // namespace gs
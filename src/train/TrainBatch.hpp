@@ -0,0 +1,171 @@
+// ============================================================
+// File: src/train/TrainBatch.hpp
+// Role: 작은 독립 장면 S개를 한 번의 submit으로 동시에 학습 (BATCHED 특수화)
+// ============================================================
+//
+// 장면마다 가우시안 수십 개 + 64×64 정도면 dispatch 1개가 workgroup 수십 개
+// → GPU 대부분이 놀고 있음. 장면 S개를 공유 버퍼에 이어 붙이고
+// workgroup z = 장면 번호로 forward / loss / backward를 한 번에 dispatch
+//
+// 버퍼 (TrainBuffers 재사용, 장면 순서대로 packed):
+//   params / grads           : 장면 s = [paramOffset, paramOffset + gaussCount)
+//   rendered / target / loss / dLdR : 장면 s = [pixelOffset, pixelOffset + w·h)
+//   sceneTable               : BatchScene[S] (shader와 1:1)
+//
+// dispatch 격자 = (배치 최대 W, 최대 H, S) → 작은 장면의 남는 workgroup은 즉시 종료
+//   → 크기가 비슷한 장면끼리 묶을수록 낭비가 적음
+// 제한: GRAD_ATOMIC 전용, 전체 이미지 학습만 (sampled / 계측 / pyramid 없음)
+// ============================================================
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+#include "common/GaussianTypes.hpp"
+#include "engine/VkBuffer.hpp"
+#include "engine/VkCompute.hpp"
+#include "train/TrainPasses.hpp"
+
+namespace gs {
+
+// maxComputeWorkGroupCount[2] 최소 보장값
+const uint32_t BATCH_MAX_SCENES = 65535;
+
+// shader BatchScene과 1:1 (std430, 32 bytes)
+struct BatchScene {
+    uint32_t paramOffset;
+    uint32_t gaussCount;
+    uint32_t pixelOffset;
+    uint32_t width;
+    uint32_t height;
+    uint32_t _pad0, _pad1, _pad2;
+};
+
+static_assert(sizeof(BatchScene) == 32, "BatchScene must be 32 bytes");
+
+struct BatchSceneSize {
+    uint32_t gaussCount;
+    uint32_t width;
+    uint32_t height;
+};
+
+struct BatchLayout {
+    std::vector<BatchScene> scenes;
+    uint32_t totalGaussians = 0;
+    uint32_t totalPixels    = 0;
+    uint32_t maxWidth       = 0;
+    uint32_t maxHeight      = 0;
+    uint32_t maxGaussians   = 0;
+
+    uint32_t sceneCount() const { return uint32_t(scenes.size()); }
+};
+
+// ------------------------------------------------------------
+// makeBatchLayout: 장면 크기 목록 → 오프셋 테이블 (입력 순서 그대로 packed)
+// ------------------------------------------------------------
+inline BatchLayout makeBatchLayout(const std::vector<BatchSceneSize>& sizes) {
+    if (sizes.empty() || sizes.size() > BATCH_MAX_SCENES) {
+        throw std::runtime_error("Batch scene count must be 1.." + std::to_string(BATCH_MAX_SCENES));
+    }
+    BatchLayout layout;
+    layout.scenes.reserve(sizes.size());
+    uint64_t gaussTotal = 0;
+    uint64_t pixelTotal = 0;
+    for (const BatchSceneSize& sz : sizes) {
+        BatchScene s{};
+        s.paramOffset = uint32_t(gaussTotal);
+        s.gaussCount  = sz.gaussCount;
+        s.pixelOffset = uint32_t(pixelTotal);
+        s.width       = sz.width;
+        s.height      = sz.height;
+        layout.scenes.push_back(s);
+
+        gaussTotal += sz.gaussCount;
+        pixelTotal += uint64_t(sz.width) * sz.height;
+        layout.maxWidth     = std::max(layout.maxWidth, sz.width);
+        layout.maxHeight    = std::max(layout.maxHeight, sz.height);
+        layout.maxGaussians = std::max(layout.maxGaussians, sz.gaussCount);
+    }
+    if (gaussTotal > UINT32_MAX || pixelTotal > UINT32_MAX) {
+        throw std::runtime_error("Batch too large for 32-bit offsets");
+    }
+    layout.totalGaussians = uint32_t(gaussTotal);
+    layout.totalPixels    = uint32_t(pixelTotal);
+    return layout;
+}
+
+// ------------------------------------------------------------
+// createBatchTrainBuffers: 전체 장면을 담는 TrainBuffers + 장면 테이블 업로드
+// ------------------------------------------------------------
+// 이미지 버퍼는 totalPixels × 1 한 줄로 할당 (장면별 2D 구조는 테이블이 가짐)
+// target은 totalPixels vec4로 따로 만들어 bindTarget
+// ------------------------------------------------------------
+inline TrainBuffers createBatchTrainBuffers(
+    VkDevice device,
+    VkPhysicalDevice physicalDevice,
+    const BatchLayout& layout
+) {
+    TrainBuffers b = createTrainBuffers(device, physicalDevice,
+        layout.totalGaussians, layout.totalPixels, 1, GRAD_ATOMIC);
+
+    destroyBuffer(device, b.sceneTable);
+    const VkDeviceSize tableSize = layout.scenes.size() * sizeof(BatchScene);
+    b.sceneTable = createBuffer(device, physicalDevice, tableSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    uploadToBuffer(device, b.sceneTable, layout.scenes.data(), tableSize);
+    return b;
+}
+
+// ------------------------------------------------------------
+// recordTrainStepBatched: S개 장면 forward → loss → backward (dispatch 3개)
+// ------------------------------------------------------------
+// p는 createTrainPipelines(..., batched = true)
+// push constant width/height = 배치 최대 크기 (shader는 장면 크기를 테이블에서 읽음)
+// grads는 호출 전에 0 초기화 (GRAD_ATOMIC)
+// ------------------------------------------------------------
+inline void recordTrainStepBatched(
+    VkCommandBuffer cmd,
+    const TrainPipelines& p,
+    const BatchLayout& layout,
+    float ssimWeight
+) {
+    const uint32_t S = layout.sceneCount();
+    RenderPC renderPC{ layout.maxWidth, layout.maxHeight, layout.maxGaussians, 1.0f, SAMPLE_NONE };
+    LossPC lossPC{ layout.maxWidth, layout.maxHeight, ssimWeight, SAMPLE_NONE };
+
+    recordDispatch(cmd, p.render, &renderPC, sizeof(renderPC),
+        (layout.maxWidth + 7) / 8, (layout.maxHeight + 7) / 8, S);
+    recordComputeBarrier(cmd);
+    recordDispatch(cmd, p.loss, &lossPC, sizeof(lossPC),
+        (layout.maxWidth + 15) / 16, (layout.maxHeight + 15) / 16, S);
+    recordComputeBarrier(cmd);
+    recordDispatch(cmd, p.backward, &renderPC, sizeof(renderPC),
+        (layout.maxWidth + 7) / 8, (layout.maxHeight + 7) / 8, S);
+}
+
+// forward만 (target 렌더 / 최종 이미지용)
+inline void recordForwardBatched(VkCommandBuffer cmd, const TrainPipelines& p, const BatchLayout& layout) {
+    RenderPC renderPC{ layout.maxWidth, layout.maxHeight, layout.maxGaussians, 1.0f, SAMPLE_NONE };
+    recordDispatch(cmd, p.render, &renderPC, sizeof(renderPC),
+        (layout.maxWidth + 7) / 8, (layout.maxHeight + 7) / 8, layout.sceneCount());
+}
+
+// ------------------------------------------------------------
+// readBatchLosses: 픽셀 loss → 장면별 합 (고정 순서 합산)
+// ------------------------------------------------------------
+inline void readBatchLosses(VkDevice device, TrainBuffers& b, const BatchLayout& layout, std::vector<float>& out) {
+    std::vector<float> pixelLoss(layout.totalPixels);
+    downloadFromBuffer(device, b.loss, pixelLoss.data(), VkDeviceSize(layout.totalPixels) * sizeof(float));
+    out.assign(layout.scenes.size(), 0.0f);
+    for (size_t s = 0; s < layout.scenes.size(); s++) {
+        const BatchScene& sc = layout.scenes[s];
+        const uint32_t count = sc.width * sc.height;
+        for (uint32_t i = 0; i < count; i++) out[s] += pixelLoss[sc.pixelOffset + i];
+    }
+}
+
+} // namespace gs
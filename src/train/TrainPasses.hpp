@@ -0,0 +1,675 @@
+// ============================================================
+// File: src/train/TrainPasses.hpp
+// Role: 학습 pass (forward / loss / backward / downsample) 공용 구성
+//       main.cpp 학습 루프와 bench가 같은 pipeline/버퍼/기록 코드를 사용
+// ============================================================
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+#include "common/GaussianTypes.hpp"
+#include "engine/VkEngine.hpp"
+#include "engine/VkBuffer.hpp"
+#include "engine/VkCompute.hpp"
+
+namespace gs {
+
+// ------------------------------------------------------------
+// Push Constants (shader 쪽 layout(push_constant)와 1:1)
+// ------------------------------------------------------------
+struct RenderPC {
+    uint32_t width;
+    uint32_t height;
+    uint32_t gaussCount;
+    float    pixelScale;  // 렌더 픽셀 1개 = full-res 픽셀 몇 개 (2^level)
+    uint32_t sampled;     // 0 = 전체 이미지, SampleMode = 샘플 타일만
+    float    depthScale = 1.0f;  // BLEND_OIT 깊이 가중치 정규화 (z / depthScale), 정렬 경로는 읽지 않음
+};
+
+struct LossPC {
+    uint32_t width;
+    uint32_t height;
+    float    ssimWeight;  // L = (1-λ)·L1 + λ·(1-SSIM)
+    uint32_t sampled;
+};
+
+// ------------------------------------------------------------
+// Stochastic 학습: 매 iteration 16×16 타일 일부만 forward/loss/backward
+// ------------------------------------------------------------
+// Tiles: K개 타일 균등 추출 (복원), loss 영역 = 타일별
+// Crop : cropTilesX × cropTilesY 연속 영역, loss 영역 = crop 전체
+// ------------------------------------------------------------
+enum SampleMode : uint32_t {
+    SAMPLE_NONE  = 0,
+    SAMPLE_TILES = 1,
+    SAMPLE_CROP  = 2,
+};
+
+const uint32_t SAMPLE_TILE = 16;  // loss.comp TILE과 동일
+
+// 한 step 타일 수 상한: 8×8 kernel은 타일당 workgroup 4개를 x로만 펼침
+//   → count × 4 ≤ maxComputeWorkGroupCount[0] 최소 보장값 65535
+// sample_tiles.comp MAX_TILES와 동일
+const uint32_t SAMPLE_MAX_TILES = 65535 / 4;
+
+struct SamplePC {
+    uint32_t width;
+    uint32_t height;
+    uint32_t seed;
+    uint32_t iteration;   // RNG 입력 (같은 seed + iteration → 같은 타일)
+    uint32_t mode;        // SAMPLE_TILES / SAMPLE_CROP
+    uint32_t tileCount;
+    uint32_t cropTilesX;
+    uint32_t cropTilesY;
+};
+
+// Samples 버퍼 레이아웃 (sample_tiles.comp와 동일)
+//   [0]  dispatch8  (uvec4) → 8×8 kernel indirect 인자
+//   [16] dispatch16 (uvec4) → 16×16 kernel indirect 인자
+//   [32] region     (uvec4)
+//   [48] tiles[]    (uvec2)
+const VkDeviceSize SAMPLE_DISPATCH8_OFFSET  = 0;
+const VkDeviceSize SAMPLE_DISPATCH16_OFFSET = 16;
+const VkDeviceSize SAMPLE_HEADER_SIZE       = 48;
+
+// 이 해상도에서 실제로 뽑을 타일 수 (완전한 타일 격자 기준, SAMPLE_MAX_TILES로 제한)
+// 0 = 샘플링 불필요 (격자가 K 이하 → 전체 이미지 학습이 더 쌈)
+// crop은 너비 유지, 높이를 줄여 상한 안으로 (shader도 같은 규칙)
+inline uint32_t sampledTileCount(const SamplePC& pc) {
+    uint32_t gridW = pc.width / SAMPLE_TILE;
+    uint32_t gridH = pc.height / SAMPLE_TILE;
+    if (pc.mode == SAMPLE_CROP) {
+        uint32_t cw = std::min({ pc.cropTilesX, gridW, SAMPLE_MAX_TILES });
+        uint32_t ch = std::min({ pc.cropTilesY, gridH, cw > 0 ? SAMPLE_MAX_TILES / cw : 0u });
+        return (cw * ch < gridW * gridH) ? cw * ch : 0;
+    }
+    if (pc.mode == SAMPLE_TILES) {
+        uint32_t count = std::min(pc.tileCount, SAMPLE_MAX_TILES);
+        return (count < gridW * gridH) ? count : 0;
+    }
+    return 0;
+}
+
+// ------------------------------------------------------------
+// Backward 누적 방식
+// ------------------------------------------------------------
+// ATOMIC       : backward.comp - 픽셀마다 int atomicAdd (GRAD_SCALE 고정소수점)
+// DETERMINISTIC: backward_tiles.comp → grad_reduce.comp
+//                16×16 타일 부분합을 scratch에 기록 → 가우시안별 고정 순서 합산
+//                float 그대로 누적 (고정소수점 절삭/overflow 없음)
+//                같은 장치/드라이버 + 같은 입력 → grads 비트 동일
+// ------------------------------------------------------------
+enum GradMode : uint32_t {
+    GRAD_ATOMIC        = 0,
+    GRAD_DETERMINISTIC = 1,
+};
+
+const uint32_t     GRAD_TILE          = 16;                  // backward_tiles.comp local_size
+const VkDeviceSize GRAD_SCRATCH_BYTES = 256ull << 20;        // 타일 부분합 scratch 기본 크기
+const uint32_t     GRAD_MAX_CHUNK     = 65535;               // grad_reduce dispatch x 한도
+
+// backward_tiles.comp 부분합 1개 (타일 × 가우시안)
+struct GradPartial {
+    glm::vec4 colorPosX;  // dColor.rgb, dPosition.x
+    glm::vec4 posY;       // dPosition.y, -, -, -
+};
+static_assert(sizeof(GradPartial) == 32, "GradPartial must be 32 bytes");
+
+struct BackwardTilesPC {
+    uint32_t width;
+    uint32_t height;
+    uint32_t gaussCount;
+    float    pixelScale;
+    uint32_t sampled;
+    uint32_t gaussFirst;  // 이번 구간 첫 가우시안
+    uint32_t chunkCount;  // 이번 구간 가우시안 수
+    uint32_t tileSlots;   // 부분합 행 길이 (= 이번 step 타일 수)
+};
+
+struct GradReducePC {
+    uint32_t gaussFirst;
+    uint32_t chunkCount;
+    uint32_t tileSlots;
+};
+
+struct DownsamplePC {
+    uint32_t srcWidth;
+    uint32_t srcHeight;
+    uint32_t dstWidth;
+    uint32_t dstHeight;
+};
+
+// ------------------------------------------------------------
+// 융합 step (train_fused.comp): 16×16 타일마다 forward → loss → backward
+// ------------------------------------------------------------
+// rendered / dLdR 전체 이미지를 DRAM에 쓰지 않음 (debugImages != 0 일 때만)
+// loss는 타일당 합 1개 → readFusedLoss
+// SSIM (λ > 0): halo 포함 36×36 footprint 렌더, shared ≈ 43KB
+//   → 장치 maxComputeSharedMemorySize가 모자라면 pipeline을 만들지 않음 (fusedSsim = false)
+// L1 (λ = 0): footprint = 타일, shared 12KB
+// 전체 이미지 + GRAD_ATOMIC 전용
+// ------------------------------------------------------------
+struct FusedPC {
+    uint32_t width;
+    uint32_t height;
+    uint32_t gaussCount;
+    float    pixelScale;
+    float    ssimWeight;
+    uint32_t debugImages;  // 1 = rendered / dLdR도 기록
+};
+
+// train_fused.comp의 TILE / R / IN / MID와 동일 (SSIM_ON = 1, HALO = 2R)
+const uint32_t FUSED_TILE     = 16;
+const uint32_t FUSED_SSIM_R   = 5;
+const uint32_t FUSED_SSIM_IN  = FUSED_TILE + 4 * FUSED_SSIM_R;  // 36
+const uint32_t FUSED_SSIM_MID = FUSED_TILE + 2 * FUSED_SSIM_R;  // 26
+
+// SSIM_ON = 1 shared 크기 (byte): train_fused.comp의 shared 선언 sX / sIn / sH / sRed 순서
+const uint32_t FUSED_SHARED_SSIM = (FUSED_SSIM_IN * FUSED_SSIM_IN * 3 +
+                                    FUSED_SSIM_MID * FUSED_SSIM_MID * 3 +
+                                    FUSED_SSIM_IN * FUSED_SSIM_MID * 5 +
+                                    FUSED_TILE * FUSED_TILE) * sizeof(float);
+
+inline uint32_t fusedTileCount(uint32_t width, uint32_t height) {
+    return ((width + FUSED_TILE - 1) / FUSED_TILE) * ((height + FUSED_TILE - 1) / FUSED_TILE);
+}
+
+// ------------------------------------------------------------
+// 블렌딩 방식 (forward / backward 기록마다 선택)
+// ------------------------------------------------------------
+// SORTED: gaussian.comp / backward.comp - 배열 순서 front-to-back (정확)
+//         배열이 깊이순이어야 함 (sortByDepth, 호출 측 책임)
+// OIT   : gaussian_oit.comp / backward_oit.comp - weighted blended OIT
+//         정렬 불필요한 근사 (미리보기 / 초기 iteration용)
+//         early termination 없음 → 픽셀마다 가우시안 전부 평가
+//         전체 이미지 + GRAD_ATOMIC 전용 (sampled / batched / 계측 없음)
+// ------------------------------------------------------------
+enum BlendMode : uint32_t {
+    BLEND_SORTED = 0,
+    BLEND_OIT    = 1,
+};
+
+// ------------------------------------------------------------
+// TrainPipelines: 학습 1 step에 필요한 compute pipeline 묶음
+// ------------------------------------------------------------
+// instrumented: gaussian/backward를 INSTRUMENT = true로 특수화한 계측 빌드
+//   (블록 카운터 기록, 시간 측정용으로는 쓰지 않음 - Counters.hpp)
+// batched: gaussian/loss/backward를 BATCHED = true로 특수화 (TrainBatch.hpp)
+//   workgroup z = 장면 번호, 장면 테이블로 오프셋/크기 결정
+//   계측과 같이 쓰지 않음 (카운터 격자는 장면 1개 기준 → 장면끼리 섞임, 생성 시 거부)
+// ------------------------------------------------------------
+struct TrainPipelines {
+    ComputeContext render;      // gaussian.comp   (params, image, samples, counters, scenes)
+    ComputeContext loss;        // loss.comp       (rendered, target, loss, dL/dR, samples, scenes)
+    ComputeContext backward;    // backward.comp   (params, grads, dL/dR, samples, counters, scenes)
+    ComputeContext downsample;  // downsample.comp (src, dst)
+    ComputeContext sample;      // sample_tiles.comp (samples)
+    ComputeContext backwardTiles;  // backward_tiles.comp (params, dL/dR, samples, pixelT, partials)
+    ComputeContext gradReduce;     // grad_reduce.comp    (partials, grads)
+    ComputeContext renderOit;      // gaussian_oit.comp   (params, image)
+    ComputeContext backwardOit;    // backward_oit.comp   (params, grads, dL/dR)
+    ComputeContext fused;          // train_fused.comp SSIM_ON = 1 (params, grads, target, loss, image, dL/dR)
+    ComputeContext fusedL1;        // train_fused.comp SSIM_ON = 0 (같은 binding)
+    bool           fusedSsim    = false;  // fused pipeline 생성 여부 (shared memory 한도)
+    bool           instrumented = false;
+    bool           batched      = false;
+};
+
+// shaderDir 예시: "../src/shaders/" (build 폴더에서 실행 기준)
+inline TrainPipelines createTrainPipelines(
+    const VkEngine& engine,
+    const std::string& shaderDir,
+    bool instrument = false,
+    bool batched = false
+) {
+    if (instrument && batched) {
+        // gaussian/backward의 카운터 블록 번호에 장면(workgroup z) 구분 없음
+        throw std::runtime_error("createTrainPipelines: instrument and batched cannot be combined");
+    }
+    DescriptorSystem& ds = engine.descriptors();
+    // constant_id 0 = INSTRUMENT, 1 = BATCHED (loss.comp는 1만 사용)
+    const std::vector<uint32_t> spec = { instrument ? 1u : 0u, batched ? 1u : 0u };
+    TrainPipelines p;
+    p.instrumented = instrument;
+    p.batched      = batched;
+    p.render     = createComputePipeline(ds, shaderDir + "gaussian.spv",     5, sizeof(RenderPC), spec);
+    p.loss       = createComputePipeline(ds, shaderDir + "loss.spv",         6, sizeof(LossPC), spec);
+    p.backward   = createComputePipeline(ds, shaderDir + "backward.spv",     6, sizeof(RenderPC), spec);
+    p.downsample = createComputePipeline(ds, shaderDir + "downsample.spv",   2, sizeof(DownsamplePC));
+    p.sample     = createComputePipeline(ds, shaderDir + "sample_tiles.spv", 1, sizeof(SamplePC));
+    p.backwardTiles = createComputePipeline(ds, shaderDir + "backward_tiles.spv", 5, sizeof(BackwardTilesPC));
+    p.gradReduce    = createComputePipeline(ds, shaderDir + "grad_reduce.spv",    2, sizeof(GradReducePC));
+    p.renderOit     = createComputePipeline(ds, shaderDir + "gaussian_oit.spv",   2, sizeof(RenderPC));
+    p.backwardOit   = createComputePipeline(ds, shaderDir + "backward_oit.spv",   3, sizeof(RenderPC));
+
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(engine.physicalDevice(), &props);
+    p.fusedSsim = props.limits.maxComputeSharedMemorySize >= FUSED_SHARED_SSIM;
+    if (p.fusedSsim) {
+        p.fused = createComputePipeline(ds, shaderDir + "train_fused.spv", 6, sizeof(FusedPC), { 1u });
+    } else {
+        printf("  [Info] Fused SSIM step disabled (shared memory %u < %u bytes)\n",
+            props.limits.maxComputeSharedMemorySize, FUSED_SHARED_SSIM);
+    }
+    p.fusedL1 = createComputePipeline(ds, shaderDir + "train_fused.spv", 6, sizeof(FusedPC), { 0u });
+    return p;
+}
+
+inline void destroyTrainPipelines(VkDevice device, TrainPipelines& p) {
+    destroyComputePipeline(device, p.render);
+    destroyComputePipeline(device, p.loss);
+    destroyComputePipeline(device, p.backward);
+    destroyComputePipeline(device, p.downsample);
+    destroyComputePipeline(device, p.sample);
+    destroyComputePipeline(device, p.backwardTiles);
+    destroyComputePipeline(device, p.gradReduce);
+    destroyComputePipeline(device, p.renderOit);
+    destroyComputePipeline(device, p.backwardOit);
+    if (p.fusedSsim) destroyComputePipeline(device, p.fused);
+    destroyComputePipeline(device, p.fusedL1);
+}
+
+// ------------------------------------------------------------
+// TrainBuffers: full 해상도 기준으로 1번 할당
+// ------------------------------------------------------------
+// target은 포함하지 않음 (피라미드 level마다 다르므로 bindTarget으로 따로)
+//
+// params/grads/loss: HOST_VISIBLE (매 iteration CPU 업로드/다운로드)
+// rendered: HOST_VISIBLE (최종 이미지 저장용)
+// dLdR: DEVICE_LOCAL (loss → backward, GPU 내부 전용)
+// samples: DEVICE_LOCAL + INDIRECT (sample_tiles.comp → indirect dispatch)
+// forward/backwardCounters: HOST_VISIBLE, 8×8 블록당 uvec4 (계측 빌드만 기록,
+//   일반 빌드도 shader가 binding을 선언하므로 항상 할당)
+// pixelT/gradScratch: DEVICE_LOCAL, GRAD_DETERMINISTIC 전용
+//   (ATOMIC이면 16 byte 자리만 - binding 유효성용)
+// grads 해석: ATOMIC = GaussianGradInt, DETERMINISTIC = GaussianGrad (readGradients)
+// sceneTable: HOST_VISIBLE, 배치 학습 장면 테이블 (TrainBatch.hpp가 교체,
+//   단일 장면이면 32 byte 자리만)
+// ------------------------------------------------------------
+struct TrainBuffers {
+    BufferBundle params;
+    BufferBundle grads;
+    BufferBundle rendered;
+    BufferBundle loss;
+    BufferBundle dLdR;
+    BufferBundle samples;
+    BufferBundle forwardCounters;
+    BufferBundle backwardCounters;
+    BufferBundle pixelT;       // 구간 사이 transmittance, 타일 슬롯 × 256
+    BufferBundle gradScratch;  // GradPartial[chunk][tileSlots]
+    BufferBundle sceneTable;   // BatchScene[] (TrainBatch.hpp)
+    GradMode     gradMode = GRAD_ATOMIC;
+};
+
+const uint32_t COUNTER_BLOCK = 8;  // gaussian.comp / backward.comp 카운터 블록 = 8×8 픽셀
+
+inline TrainBuffers createTrainBuffers(
+    VkDevice device,
+    VkPhysicalDevice physicalDevice,
+    uint32_t gaussCount,
+    uint32_t width,
+    uint32_t height,
+    GradMode gradMode = GRAD_ATOMIC,
+    VkDeviceSize scratchBytes = GRAD_SCRATCH_BYTES
+) {
+    const VkDeviceSize pixelCount = VkDeviceSize(width) * height;
+    const VkMemoryPropertyFlags hostMem =
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    TrainBuffers b;
+    b.gradMode = gradMode;
+    b.params   = createBuffer(device, physicalDevice, gaussCount * sizeof(GaussianParam),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostMem);
+    b.grads    = createBuffer(device, physicalDevice, gaussCount * sizeof(GaussianGrad),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostMem);
+    b.rendered = createBuffer(device, physicalDevice, pixelCount * sizeof(glm::vec4),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostMem);
+    b.loss     = createBuffer(device, physicalDevice, pixelCount * sizeof(float),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostMem);
+    b.dLdR     = createBuffer(device, physicalDevice, pixelCount * sizeof(glm::vec4),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    // 최대 타일 수 = 완전한 타일 격자 (sampledTileCount가 이 이하로 제한)
+    const VkDeviceSize maxTiles = VkDeviceSize(width / SAMPLE_TILE) * (height / SAMPLE_TILE);
+    b.samples  = createBuffer(device, physicalDevice,
+        SAMPLE_HEADER_SIZE + std::max<VkDeviceSize>(maxTiles, 1) * 2 * sizeof(uint32_t),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    const VkDeviceSize counterBlocks = VkDeviceSize((width + COUNTER_BLOCK - 1) / COUNTER_BLOCK) *
+        ((height + COUNTER_BLOCK - 1) / COUNTER_BLOCK);
+    b.forwardCounters  = createBuffer(device, physicalDevice, counterBlocks * 4 * sizeof(uint32_t),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, hostMem);
+    b.backwardCounters = createBuffer(device, physicalDevice, counterBlocks * 4 * sizeof(uint32_t),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, hostMem);
+
+    // scratch는 타일 1행(full 해상도 타일 수)이 최소 1개 가우시안분은 들어가야 함
+    const VkDeviceSize maxTileSlots = VkDeviceSize((width + GRAD_TILE - 1) / GRAD_TILE) *
+        ((height + GRAD_TILE - 1) / GRAD_TILE);
+    const bool deterministic = gradMode == GRAD_DETERMINISTIC;
+    b.pixelT      = createBuffer(device, physicalDevice,
+        deterministic ? maxTileSlots * GRAD_TILE * GRAD_TILE * sizeof(float) : 16,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    b.gradScratch = createBuffer(device, physicalDevice,
+        deterministic ? std::max(scratchBytes, maxTileSlots * sizeof(GradPartial)) : 16,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    b.sceneTable  = createBuffer(device, physicalDevice, 32, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostMem);
+    return b;
+}
+
+inline void destroyTrainBuffers(VkDevice device, TrainBuffers& b) {
+    destroyBuffer(device, b.params);
+    destroyBuffer(device, b.grads);
+    destroyBuffer(device, b.rendered);
+    destroyBuffer(device, b.loss);
+    destroyBuffer(device, b.dLdR);
+    destroyBuffer(device, b.samples);
+    destroyBuffer(device, b.forwardCounters);
+    destroyBuffer(device, b.backwardCounters);
+    destroyBuffer(device, b.pixelT);
+    destroyBuffer(device, b.gradScratch);
+    destroyBuffer(device, b.sceneTable);
+}
+
+// ------------------------------------------------------------
+// bindTrainBuffers: target 제외 전체 binding 설정
+// ------------------------------------------------------------
+// samples는 전체 이미지 모드(sampled = 0)에서도 바인딩 (shader가 읽지 않음)
+// binding은 dispatch 기록 시점에 적용 (VkCompute.hpp DescriptorSystem)
+// ------------------------------------------------------------
+inline void bindTrainBuffers(TrainPipelines& p, const TrainBuffers& b) {
+    bindSSBO(p.render, b.params,          0);
+    bindSSBO(p.render, b.rendered,        1);
+    bindSSBO(p.render, b.samples,         2);
+    bindSSBO(p.render, b.forwardCounters, 3);
+    bindSSBO(p.render, b.sceneTable,      4);
+
+    bindSSBO(p.loss, b.rendered,   0);
+    bindSSBO(p.loss, b.loss,       2);
+    bindSSBO(p.loss, b.dLdR,       3);
+    bindSSBO(p.loss, b.samples,    4);
+    bindSSBO(p.loss, b.sceneTable, 5);
+
+    bindSSBO(p.backward, b.params,           0);
+    bindSSBO(p.backward, b.grads,            1);
+    bindSSBO(p.backward, b.dLdR,             2);
+    bindSSBO(p.backward, b.samples,          3);
+    bindSSBO(p.backward, b.backwardCounters, 4);
+    bindSSBO(p.backward, b.sceneTable,       5);
+
+    bindSSBO(p.backwardTiles, b.params,      0);
+    bindSSBO(p.backwardTiles, b.dLdR,        1);
+    bindSSBO(p.backwardTiles, b.samples,     2);
+    bindSSBO(p.backwardTiles, b.pixelT,      3);
+    bindSSBO(p.backwardTiles, b.gradScratch, 4);
+
+    bindSSBO(p.gradReduce, b.gradScratch, 0);
+    bindSSBO(p.gradReduce, b.grads,       1);
+
+    bindSSBO(p.renderOit, b.params,   0);
+    bindSSBO(p.renderOit, b.rendered, 1);
+
+    bindSSBO(p.backwardOit, b.params, 0);
+    bindSSBO(p.backwardOit, b.grads,  1);
+    bindSSBO(p.backwardOit, b.dLdR,   2);
+
+    for (ComputeContext* ctx : { &p.fused, &p.fusedL1 }) {
+        if (ctx->pipeline == VK_NULL_HANDLE) continue;
+        bindSSBO(*ctx, b.params,   0);
+        bindSSBO(*ctx, b.grads,    1);
+        bindSSBO(*ctx, b.loss,     3);
+        bindSSBO(*ctx, b.rendered, 4);
+        bindSSBO(*ctx, b.dLdR,     5);
+    }
+
+    bindSSBO(p.sample, b.samples, 0);
+}
+
+// target 교체 (피라미드 level 전환 등) - 이후 기록하는 loss pass부터 적용
+inline void bindTarget(TrainPipelines& p, const BufferBundle& target) {
+    bindSSBO(p.loss, target, 1);
+    if (p.fusedSsim) bindSSBO(p.fused, target, 2);
+    bindSSBO(p.fusedL1, target, 2);
+}
+
+// ------------------------------------------------------------
+// Pass 기록 (workgroup 크기는 각 shader의 local_size와 일치)
+// ------------------------------------------------------------
+inline void recordForward(VkCommandBuffer cmd, const TrainPipelines& p, const RenderPC& pc,
+                          BlendMode blend = BLEND_SORTED) {
+    const ComputeContext& ctx = (blend == BLEND_OIT) ? p.renderOit : p.render;
+    recordDispatch(cmd, ctx, &pc, sizeof(pc), (pc.width + 7) / 8, (pc.height + 7) / 8);
+}
+
+inline void recordLoss(VkCommandBuffer cmd, const TrainPipelines& p, const LossPC& pc) {
+    // loss.comp = 16×16 타일
+    recordDispatch(cmd, p.loss, &pc, sizeof(pc), (pc.width + 15) / 16, (pc.height + 15) / 16);
+}
+
+inline void recordBackward(VkCommandBuffer cmd, const TrainPipelines& p, const RenderPC& pc,
+                           BlendMode blend = BLEND_SORTED) {
+    const ComputeContext& ctx = (blend == BLEND_OIT) ? p.backwardOit : p.backward;
+    recordDispatch(cmd, ctx, &pc, sizeof(pc), (pc.width + 7) / 8, (pc.height + 7) / 8);
+}
+
+// ------------------------------------------------------------
+// recordBackwardDeterministic: 가우시안 구간마다 tiles → reduce
+// ------------------------------------------------------------
+// 구간 크기 = scratch에 들어가는 만큼 (tileSlots × chunk × 32 byte)
+// 구간 순서대로 pixelT를 이어받으므로 구간 분할과 무관하게 같은 결과
+// tileSlots: 전체 모드 = ceil(W/16)·ceil(H/16), sampled = sampledTileCount
+// ------------------------------------------------------------
+inline void recordBackwardDeterministic(
+    VkCommandBuffer cmd,
+    const TrainPipelines& p,
+    const TrainBuffers& b,
+    const RenderPC& pc,
+    uint32_t tileSlots
+) {
+    const uint32_t groupsX = (pc.width + GRAD_TILE - 1) / GRAD_TILE;
+    const uint32_t groupsY = (pc.height + GRAD_TILE - 1) / GRAD_TILE;
+    if (pc.sampled == SAMPLE_NONE) tileSlots = groupsX * groupsY;
+    if (tileSlots == 0 || pc.gaussCount == 0) return;
+
+    const VkDeviceSize rowBytes = VkDeviceSize(tileSlots) * sizeof(GradPartial);
+    const uint32_t chunk = uint32_t(std::max<VkDeviceSize>(1,
+        std::min<VkDeviceSize>({ VkDeviceSize(pc.gaussCount), VkDeviceSize(GRAD_MAX_CHUNK), b.gradScratch.size / rowBytes })));
+
+    for (uint32_t first = 0; first < pc.gaussCount; first += chunk) {
+        const uint32_t count = std::min(chunk, pc.gaussCount - first);
+        BackwardTilesPC tilesPC{ pc.width, pc.height, pc.gaussCount, pc.pixelScale, pc.sampled,
+            first, count, tileSlots };
+        if (pc.sampled != SAMPLE_NONE) {
+            recordDispatchIndirect(cmd, p.backwardTiles, &tilesPC, sizeof(tilesPC),
+                b.samples.buffer, SAMPLE_DISPATCH16_OFFSET);
+        } else {
+            recordDispatch(cmd, p.backwardTiles, &tilesPC, sizeof(tilesPC), groupsX, groupsY);
+        }
+        recordComputeBarrier(cmd);
+
+        GradReducePC reducePC{ first, count, tileSlots };
+        recordDispatch(cmd, p.gradReduce, &reducePC, sizeof(reducePC), count);
+        if (first + count < pc.gaussCount) recordComputeBarrier(cmd);  // scratch 재사용 전
+    }
+}
+
+// b.gradMode에 따라 backward 기록 (ATOMIC은 grads 0 초기화가 호출 측 책임)
+inline void recordBackwardPass(
+    VkCommandBuffer cmd,
+    const TrainPipelines& p,
+    const TrainBuffers& b,
+    const RenderPC& pc,
+    uint32_t tileSlots = 0
+) {
+    if (b.gradMode == GRAD_DETERMINISTIC) {
+        recordBackwardDeterministic(cmd, p, b, pc, tileSlots);
+    } else {
+        recordBackward(cmd, p, pc);
+    }
+}
+
+// forward → loss → backward (사이 barrier 포함)
+// BLEND_OIT는 GRAD_ATOMIC 버퍼 + 전체 이미지만 (그 외 조합은 예외)
+inline void recordTrainStep(
+    VkCommandBuffer cmd,
+    const TrainPipelines& p,
+    const TrainBuffers& b,
+    const RenderPC& renderPC,
+    const LossPC& lossPC,
+    BlendMode blend = BLEND_SORTED
+) {
+    if (blend == BLEND_OIT && (b.gradMode != GRAD_ATOMIC || renderPC.sampled != SAMPLE_NONE || p.batched)) {
+        throw std::runtime_error("OIT blend supports only full-image GRAD_ATOMIC training");
+    }
+    recordForward(cmd, p, renderPC, blend);
+    recordComputeBarrier(cmd);
+    recordLoss(cmd, p, lossPC);
+    recordComputeBarrier(cmd);
+    if (blend == BLEND_OIT) {
+        recordBackward(cmd, p, renderPC, BLEND_OIT);
+    } else {
+        recordBackwardPass(cmd, p, b, renderPC);
+    }
+}
+
+// ------------------------------------------------------------
+// recordTrainStepFused: dispatch 1개로 학습 step (GRAD_ATOMIC, grads 0 초기화는 호출 측)
+// ------------------------------------------------------------
+// pc.ssimWeight > 0 → fused (SSIM), 0 → fusedL1
+// b.loss 앞쪽 fusedTileCount(W, H)개 = 타일별 loss 합
+// ------------------------------------------------------------
+inline void recordTrainStepFused(
+    VkCommandBuffer cmd,
+    const TrainPipelines& p,
+    const TrainBuffers& b,
+    const FusedPC& pc
+) {
+    if (b.gradMode != GRAD_ATOMIC || p.batched) {
+        throw std::runtime_error("Fused step supports only single-scene GRAD_ATOMIC training");
+    }
+    const bool ssim = pc.ssimWeight > 0.0f;
+    if (ssim && !p.fusedSsim) {
+        throw std::runtime_error("Fused SSIM step not supported on this device (shared memory)");
+    }
+    recordDispatch(cmd, ssim ? p.fused : p.fusedL1, &pc, sizeof(pc),
+        (pc.width + FUSED_TILE - 1) / FUSED_TILE, (pc.height + FUSED_TILE - 1) / FUSED_TILE);
+}
+
+// 타일별 loss 합 → 전체 loss (타일 순서대로 합산)
+inline float readFusedLoss(VkDevice device, TrainBuffers& b, uint32_t width, uint32_t height) {
+    std::vector<float> tileLoss(fusedTileCount(width, height));
+    downloadFromBuffer(device, b.loss, tileLoss.data(), tileLoss.size() * sizeof(float));
+    float total = 0.0f;
+    for (float l : tileLoss) total += l;
+    return total;
+}
+
+// ------------------------------------------------------------
+// Stochastic step: sample → forward → loss → backward (타일 수는 GPU가 결정)
+// ------------------------------------------------------------
+// renderPC.sampled / lossPC.sampled = samplePC.mode 로 맞춰서 호출
+// rendered/dLdR은 샘플 타일 영역만 갱신됨 (나머지는 이전 값 유지)
+// pixelLoss는 앞쪽 sampledTileCount * 256개에 압축 기록
+// ------------------------------------------------------------
+inline void recordSampleTiles(VkCommandBuffer cmd, const TrainPipelines& p, const SamplePC& pc) {
+    recordDispatch(cmd, p.sample, &pc, sizeof(pc), 1);
+}
+
+inline void recordTrainStepSampled(
+    VkCommandBuffer cmd,
+    const TrainPipelines& p,
+    const TrainBuffers& b,
+    const SamplePC& samplePC,
+    const RenderPC& renderPC,
+    const LossPC& lossPC
+) {
+    recordSampleTiles(cmd, p, samplePC);
+    recordIndirectBarrier(cmd);
+    recordDispatchIndirect(cmd, p.render, &renderPC, sizeof(renderPC),
+        b.samples.buffer, SAMPLE_DISPATCH8_OFFSET);
+    recordComputeBarrier(cmd);
+    recordDispatchIndirect(cmd, p.loss, &lossPC, sizeof(lossPC),
+        b.samples.buffer, SAMPLE_DISPATCH16_OFFSET);
+    recordComputeBarrier(cmd);
+    if (b.gradMode == GRAD_DETERMINISTIC) {
+        recordBackwardDeterministic(cmd, p, b, renderPC, sampledTileCount(samplePC));
+    } else {
+        recordDispatchIndirect(cmd, p.backward, &renderPC, sizeof(renderPC),
+            b.samples.buffer, SAMPLE_DISPATCH8_OFFSET);
+    }
+}
+
+// ------------------------------------------------------------
+// readGradients: grads 버퍼 → float GaussianGrad (gradMode에 맞게 해석)
+// ------------------------------------------------------------
+inline void readGradients(VkDevice device, TrainBuffers& b, uint32_t count, std::vector<GaussianGrad>& out) {
+    out.resize(count);
+    if (b.gradMode == GRAD_DETERMINISTIC) {
+        downloadFromBuffer(device, b.grads, out.data(), VkDeviceSize(count) * sizeof(GaussianGrad));
+        return;
+    }
+    std::vector<GaussianGradInt> gradsInt(count);
+    downloadFromBuffer(device, b.grads, gradsInt.data(), VkDeviceSize(count) * sizeof(GaussianGradInt));
+    for (uint32_t i = 0; i < count; i++) {
+        out[i] = GaussianGrad{};
+        out[i].dPosition = glm::vec3(gradsInt[i].dPosition) / GRAD_SCALE;
+        out[i].dOpacity  = float(gradsInt[i].dOpacity) / GRAD_SCALE;
+        out[i].dScale    = glm::vec3(gradsInt[i].dScale) / GRAD_SCALE;
+        out[i].dRotation = glm::vec4(gradsInt[i].dRotation) / GRAD_SCALE;
+        out[i].dColor    = glm::vec3(gradsInt[i].dColor) / GRAD_SCALE;
+    }
+}
+
+// ------------------------------------------------------------
+// recordCounterReset: 계측 카운터 0으로 (계측 빌드 step 앞에 기록)
+// ------------------------------------------------------------
+inline void recordCounterReset(VkCommandBuffer cmd, const TrainBuffers& b) {
+    vkCmdFillBuffer(cmd, b.forwardCounters.buffer,  0, VK_WHOLE_SIZE, 0);
+    vkCmdFillBuffer(cmd, b.backwardCounters.buffer, 0, VK_WHOLE_SIZE, 0);
+
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+// ------------------------------------------------------------
+// buildTargetPyramid: level 0 → 1 → ... 순서로 2×2 downsample
+// ------------------------------------------------------------
+// level마다 src/dst binding만 바꿔 같은 command buffer에 연속 기록 → 1회 제출
+// pyramid[0]은 호출 전에 채워져 있어야 함
+// ------------------------------------------------------------
+inline void buildTargetPyramid(
+    const VkEngine& engine,
+    TrainPipelines& p,
+    VkCommandBuffer cmd,
+    std::vector<BufferBundle>& pyramid,
+    const std::vector<uint32_t>& levelW,
+    const std::vector<uint32_t>& levelH
+) {
+    if (pyramid.size() < 2) return;
+
+    beginOneTimeCommands(cmd);
+    for (size_t l = 1; l < pyramid.size(); l++) {
+        bindSSBO(p.downsample, pyramid[l - 1], 0);
+        bindSSBO(p.downsample, pyramid[l],     1);
+
+        DownsamplePC pc{ levelW[l - 1], levelH[l - 1], levelW[l], levelH[l] };
+        recordDispatch(cmd, p.downsample, &pc, sizeof(pc), (levelW[l] + 7) / 8, (levelH[l] + 7) / 8);
+        recordComputeBarrier(cmd);
+    }
+    vkEndCommandBuffer(cmd);
+
+    engine.submitAndWait(cmd);
+    vkResetCommandBuffer(cmd, 0);
+}
+
+} // namespace gs
@@ -1,12 +1,15 @@
 // ============================================================
 // File: src/utils/ImageIO.hpp
-// Role: PPM 이미지 저장 (디버깅용)
+// Role: PPM 이미지 저장 (디버깅용, 렌더 서비스 스트림 출력)
 // ============================================================
 #pragma once
 
 #include <glm/glm.hpp>
 #include <vector>
+#include <string>
 #include <fstream>
+#include <ostream>
+#include <cstdint>
 #include <cstdio>
 #include <algorithm>
 
@@ -57,4 +60,70 @@ inline bool savePPM(
     return true;
 }
 
+// ------------------------------------------------------------
+// writePPMRGBA8: RGBA8 버퍼 → PPM (P6) 스트림
+// ------------------------------------------------------------
+// 렌더 서비스용: 파일 대신 stdout/소켓 스트림에 바로 기록
+// rgba: width × height × 4 bytes (alpha는 버림)
+// ------------------------------------------------------------
+inline void writePPMRGBA8(
+    std::ostream& out,
+    const uint8_t* rgba,
+    uint32_t width,
+    uint32_t height
+) {
+    out << "P6\n" << width << " " << height << "\n255\n";
+
+    // 행 단위로 RGB 변환 후 한 번에 write
+    std::vector<char> row(size_t(width) * 3);
+    for (uint32_t y = 0; y < height; y++) {
+        const uint8_t* src = rgba + size_t(y) * width * 4;
+        for (uint32_t x = 0; x < width; x++) {
+            row[x * 3 + 0] = char(src[x * 4 + 0]);
+            row[x * 3 + 1] = char(src[x * 4 + 1]);
+            row[x * 3 + 2] = char(src[x * 4 + 2]);
+        }
+        out.write(row.data(), std::streamsize(row.size()));
+    }
+}
+
+// ------------------------------------------------------------
+// heatColor: [0, 1] → 검정 → 빨강 → 노랑 → 흰색 (계측 heatmap용)
+// ------------------------------------------------------------
+inline glm::vec4 heatColor(float t) {
+    t = std::clamp(t, 0.0f, 1.0f) * 3.0f;
+    return glm::vec4(std::min(t, 1.0f), std::clamp(t - 1.0f, 0.0f, 1.0f),
+        std::clamp(t - 2.0f, 0.0f, 1.0f), 1.0f);
+}
+
+// ------------------------------------------------------------
+// saveHeatmapPPM: 스칼라 격자 → heatColor PPM
+// ------------------------------------------------------------
+// values: width × height (row-major), maxValue = 흰색 (0 이하면 값 중 최대)
+// cellSize: 값 1개를 cellSize × cellSize 픽셀로 확대 (원본 이미지와 겹쳐 보기용)
+// ------------------------------------------------------------
+inline bool saveHeatmapPPM(
+    const std::string& filename,
+    const std::vector<float>& values,
+    uint32_t width,
+    uint32_t height,
+    float maxValue = 0.0f,
+    uint32_t cellSize = 1
+) {
+    if (maxValue <= 0.0f) {
+        for (float v : values) maxValue = std::max(maxValue, v);
+        if (maxValue <= 0.0f) maxValue = 1.0f;
+    }
+    const uint32_t outW = width * cellSize;
+    const uint32_t outH = height * cellSize;
+    std::vector<glm::vec4> pixels(size_t(outW) * outH);
+    for (uint32_t y = 0; y < outH; y++) {
+        for (uint32_t x = 0; x < outW; x++) {
+            float v = values[size_t(y / cellSize) * width + x / cellSize];
+            pixels[size_t(y) * outW + x] = heatColor(v / maxValue);
+        }
+    }
+    return savePPM(filename, pixels, outW, outH);
+}
+
 } // namespace gs
\ No newline at end of file
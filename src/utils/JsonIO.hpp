@@ -0,0 +1,42 @@
+// ============================================================
+// File: src/utils/JsonIO.hpp
+// Role: JSON 결과 기록 보조 (문자열 escape)
+// ============================================================
+#pragma once
+
+#include <string>
+#include <cstdio>
+
+namespace gs {
+
+// ------------------------------------------------------------
+// jsonEscape: fprintf("\"%s\"")로 쓰기 전 문자열 escape
+// ------------------------------------------------------------
+// 드라이버가 준 장치 이름, 사용자 입력 등에 " \ 제어문자가 있어도 올바른 JSON
+//   " → \"   \ → \\   \n \r \t → 그대로 escape   나머지 < 0x20 → \u00XX
+// UTF-8 바이트는 그대로 둠 (JSON은 UTF-8 허용)
+// ------------------------------------------------------------
+inline std::string jsonEscape(const std::string& s) {
+    std::string out;
+    out.reserve(s.size() + 2);
+    for (char c : s) {
+        switch (c) {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n";  break;
+        case '\r': out += "\\r";  break;
+        case '\t': out += "\\t";  break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(c)));
+                out += buf;
+            } else {
+                out += c;
+            }
+        }
+    }
+    return out;
+}
+
+} // namespace gs